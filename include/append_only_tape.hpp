@@ -0,0 +1,280 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_APPEND_ONLY_TAPE_HPP
+#define CPPCONTAINERS_APPEND_ONLY_TAPE_HPP
+
+#include "tape.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace container
+{
+
+	/**
+	 * Append only tape is a sequence of elements appended concurrently by any number of threads without locks,
+	 * for example log records, and read by consumers while it is appended.
+	 *
+	 * An appending thread reserves the index of its element with an atomic increment, constructs the element
+	 * in its slot and then sets the slot state to ready, or to failed if the construction threw.
+	 * Consumers only read elements whose slot is ready, and skip failed ones.
+	 *
+	 * Slots are stored in segments which are never moved nor freed before the tape, so elements never move.
+	 * Segment k holds (first_segment_size << k) slots, the first segment is allocated with the tape.
+	 * The thread appending the element in the middle of segment k installs segment k+1 ahead, publishing it with a compare and swap.
+	 * A thread reaching a segment not installed yet allocates it and publishes it the same way, freeing its own if another thread was first.
+	 *
+	 * Appending is lock-free, reading an element or its state is wait-free.
+	 * Elements are destroyed with the tape, which must not be appended concurrently to its destruction.
+	 *
+	 * \tparam T Type of the elements. Aliased as member type append_only_tape::value_type.
+	 * \tparam Allocator Type of the allocator object used to allocate segments and construct elements, concurrently. Aliased as member type append_only_tape::allocator_type.
+	 */
+	template <typename T, typename Allocator = std::allocator<T> >
+	class append_only_tape
+	{
+	public:
+		typedef T											value_type;			//!< The type of elements.
+		typedef Allocator									allocator_type;		//!< The type of allocator used for segments.
+		typedef std::size_t									size_type;			//!< Unsigned integral type, usually same as size_t.
+		typedef value_type&									reference;			//!< Reference to an element.
+		typedef const value_type&							const_reference;	//!< Reference to a const element.
+
+		/** Number of slots of the first segment, as a power of two. */
+		static const unsigned first_segment_bits = 6;
+		static const size_type first_segment_size = (size_type)1 << first_segment_bits;
+		/** Maximal number of segments, enough to address the whole memory. */
+		static const unsigned max_segments = sizeof(size_type) * 8 - first_segment_bits;
+
+	protected:
+		/** Storage of an element and its publication state. */
+		struct slot
+		{
+			enum {pending, constructed, failed};
+
+			alignas(T) unsigned char	storage[sizeof(T)];
+			std::atomic<unsigned char>	state;
+
+			slot():state(pending) {}
+
+			value_type* get() {return reinterpret_cast<value_type*>(storage);}
+			const value_type* get() const {return reinterpret_cast<const value_type*>(storage);}
+		};
+
+		typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<slot>	slot_allocator;
+
+		allocator_type			_alloc;
+		slot_allocator			_slot_alloc;
+		std::atomic<size_type>	_next;						// Index of the next reserved element.
+		std::atomic<slot*>		_segments[max_segments];	// Segments of slots, allocated on demand.
+
+	public:
+		/** Constructs an empty tape, allocating its first segment. */
+		explicit append_only_tape(const allocator_type& alloc = allocator_type()):
+		_alloc(alloc), _slot_alloc(alloc), _next(0)
+		{
+			for(unsigned k = 0; k < max_segments; ++k)
+				_segments[k].store(nullptr, std::memory_order_relaxed);
+			_segments[0].store(_allocate_segment(0), std::memory_order_release);
+		}
+
+		append_only_tape(const append_only_tape&) = delete;
+		append_only_tape& operator=(const append_only_tape&) = delete;
+
+		/** Destroys the tape and its elements, no thread must still be appending. */
+		~append_only_tape()
+		{
+			size_type count = _next.load(std::memory_order_acquire);
+			for(unsigned k = 0; k < max_segments; ++k)
+			{
+				slot* seg = _segments[k].load(std::memory_order_acquire);
+				if(!seg)
+					continue;
+				size_type first = _segment_first(k);
+				for(size_type i = 0; i < _segment_size(k) && first + i < count; ++i)
+				{
+					if(seg[i].state.load(std::memory_order_acquire) == slot::constructed)
+						std::allocator_traits<allocator_type>::destroy(_alloc, seg[i].get());
+				}
+				_deallocate_segment(seg, k);
+			}
+		}
+
+		/**
+		 * \name Producers
+		 * Functions which can be called concurrently from any thread.
+		 * @{
+		 */
+
+		/** Appends a copy of val.
+		 * \return Index of the new element. */
+		size_type push_back(const value_type& val) {return emplace_back(val);}
+
+		/** Appends val, moving it.
+		 * \return Index of the new element. */
+		size_type push_back(value_type&& val) {return emplace_back(std::move(val));}
+
+		/** Reserves the next index, constructs an element in place in its slot and publishes it.
+		 * If the construction throws, the slot is marked as failed, so consumers skip it, and the exception is rethrown.
+		 * \return Index of the new element.
+		 */
+		template <class... Args>
+		size_type emplace_back(Args&&... args)
+		{
+			size_type index = _next.fetch_add(1, std::memory_order_relaxed);
+			slot& s = _slot(index);
+			try
+			{
+				std::allocator_traits<allocator_type>::construct(_alloc, s.get(), std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				s.state.store(slot::failed, std::memory_order_release);
+				throw;
+			}
+			s.state.store(slot::constructed, std::memory_order_release);
+			_prepare_segment(index);
+			return index;
+		}
+
+		/** @} */
+
+		/**
+		 * \name Consumers
+		 * Functions which can be called concurrently from any thread.
+		 * @{
+		 */
+
+		/** Returns the number of reserved indexes, including elements not published yet. */
+		size_type size() const noexcept {return _next.load(std::memory_order_acquire);}
+
+		/** Tells if the element at index n is published. */
+		bool ready(size_type n) const {return _state(n) == slot::constructed;}
+
+		/** Tells if the construction of the element at index n threw, it is then never published. */
+		bool failed(size_type n) const {return _state(n) == slot::failed;}
+
+		/** Returns the index of the first element neither published nor failed, from index n.
+		 * Elements from n to the returned index can be read, except failed ones which must be skipped.
+		 */
+		size_type published(size_type n = 0) const
+		{
+			while(_state(n) != slot::pending)
+				++n;
+			return n;
+		}
+
+		/** Returns a reference to the element at index n, which must be published. */
+		const_reference operator[](size_type n) const
+		{
+			unsigned k = _segment_of(n);
+			return *_segments[k].load(std::memory_order_acquire)[n - _segment_first(k)].get();
+		}
+
+		/** Returns a reference to the element at index n, which must be published. */
+		reference operator[](size_type n)
+		{
+			unsigned k = _segment_of(n);
+			return *_segments[k].load(std::memory_order_acquire)[n - _segment_first(k)].get();
+		}
+
+		/** @} */
+
+	protected:
+		/** Returns the publication state of the slot of index n, pending if not reserved. */
+		unsigned char _state(size_type n) const
+		{
+			if(n >= size())
+				return slot::pending;
+			unsigned k = _segment_of(n);
+			const slot* seg = _segments[k].load(std::memory_order_acquire);
+			return seg ? seg[n - _segment_first(k)].state.load(std::memory_order_acquire) : (unsigned char)slot::pending;
+		}
+
+		/** Returns the number of slots of the segment k. */
+		static size_type _segment_size(unsigned k) {return first_segment_size << k;}
+
+		/** Returns the index of the first slot of the segment k. */
+		static size_type _segment_first(unsigned k) {return (first_segment_size << k) - first_segment_size;}
+
+		/** Returns the segment holding index n. */
+		static unsigned _segment_of(size_type n)
+		{
+			size_type v = (n + first_segment_size) >> first_segment_bits; // In [2^k, 2^(k+1))
+#if defined(__GNUC__) || defined(__clang__)
+			return (unsigned)(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll((unsigned long long)v));
+#else
+			unsigned k = 0;
+			while(v >>= 1)
+				++k;
+			return k;
+#endif
+		}
+
+		/** Returns the slot of index n, allocating its segment if needed. */
+		slot& _slot(size_type n)
+		{
+			unsigned k = _segment_of(n);
+			slot* seg = _segments[k].load(std::memory_order_acquire);
+			if(!seg)
+				seg = _install_segment(k);
+			return seg[n - _segment_first(k)];
+		}
+
+		/** Allocates the segment k and publishes it, unless another thread did it first. */
+		CONTAINER_TAPE_NOINLINE slot* _install_segment(unsigned k)
+		{
+			slot* seg = _allocate_segment(k);
+			slot* expected = nullptr;
+			if(_segments[k].compare_exchange_strong(expected, seg, std::memory_order_acq_rel, std::memory_order_acquire))
+				return seg;
+			_deallocate_segment(seg, k);
+			return expected;
+		}
+
+		/** Installs the segment following the one of index n when n is the middle of its segment,
+		 * so the segment is usually published before any thread needs it and is allocated once.
+		 * A failed allocation is ignored here: the first thread needing the segment allocates it, and reports the failure.
+		 */
+		void _prepare_segment(size_type n)
+		{
+			unsigned k = _segment_of(n);
+			if(n != _segment_first(k) + _segment_size(k) / 2 || k + 1 >= max_segments || _segments[k + 1].load(std::memory_order_acquire))
+				return;
+			try
+			{
+				_install_segment(k + 1);
+			}
+			catch(...)
+			{
+			}
+		}
+
+		slot* _allocate_segment(unsigned k)
+		{
+			size_type n = _segment_size(k);
+			slot* seg = std::allocator_traits<slot_allocator>::allocate(_slot_alloc, n);
+			for(size_type i = 0; i < n; ++i)
+				::new((void*)(seg + i)) slot();
+			return seg;
+		}
+
+		void _deallocate_segment(slot* seg, unsigned k)
+		{
+			std::allocator_traits<slot_allocator>::deallocate(_slot_alloc, seg, _segment_size(k));
+		}
+	};
+
+} // namespace container
+
+#endif // CPPCONTAINERS_APPEND_ONLY_TAPE_HPP
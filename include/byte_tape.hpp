@@ -0,0 +1,247 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_BYTE_TAPE_HPP
+#define CPPCONTAINERS_BYTE_TAPE_HPP
+
+#include "tape.hpp"
+
+#include <cstring>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+namespace container
+{
+
+	/**
+	 * Byte tape is a buffer for network and file I/O, built on a tape of bytes.
+	 *
+	 * Received bytes are appended after the last byte, read(2) writing directly into the tape slack.
+	 * Bytes to send are written from the first byte and then consumed, which only advances the tape start.
+	 * Headers can be prepended in the slack before the first byte without moving the payload.
+	 *
+	 * When room is missing after the last byte, the bytes are moved back to the begining of the storage
+	 * if this moves fewer bytes than it frees, otherwise the storage is reallocated.
+	 * So a buffer used as a queue between reads and writes stops allocating once it reached its working size,
+	 * and never moves more bytes than it received.
+	 *
+	 * I/O functions are thin wrappers of POSIX system calls: they return what the call returns and leave errno untouched.
+	 *
+	 * \tparam Allocator Type of the allocator object used to define the storage allocation model. Aliased as member type basic_byte_tape::allocator_type.
+	 */
+	template <typename Allocator = std::allocator<unsigned char> >
+	class basic_byte_tape
+	{
+	public:
+		typedef tape<unsigned char, Allocator>				tape_type;			//!< The type of underlying tape.
+		typedef typename tape_type::value_type				value_type;			//!< The type of bytes, unsigned char.
+		typedef typename tape_type::allocator_type			allocator_type;		//!< The type of allocator used for internal memory management.
+		typedef typename tape_type::size_type				size_type;			//!< Unsigned integral type, usually same as size_t.
+		typedef typename tape_type::pointer					pointer;			//!< Pointer to a byte.
+		typedef typename tape_type::const_pointer			const_pointer;		//!< Const pointer to a byte.
+		typedef typename tape_type::iterator				iterator;			//!< Random access iterator to bytes.
+		typedef typename tape_type::const_iterator			const_iterator;		//!< Random access iterator to const bytes.
+
+		/** Size of the stack buffer taking the bytes which do not fit in the tape slack when reading. */
+		static const size_type extra_read_size = 65536;
+
+	protected:
+		tape_type _tape;
+
+	public:
+		/** Constructs an empty byte tape. */
+		basic_byte_tape() {}
+
+		/** Constructs an empty byte tape, with the given allocator. */
+		explicit basic_byte_tape(const allocator_type& alloc):
+		_tape(alloc)
+		{}
+
+		/** Returns the underlying tape. */
+		const tape_type& get_tape() const noexcept {return _tape;}
+
+		/**
+		 * \name Capacity
+		 * @{
+		 */
+
+		/** Returns the number of bytes in the buffer. */
+		size_type size() const noexcept {return _tape.size();}
+
+		/** Tells if the buffer is empty. */
+		bool empty() const noexcept {return _tape.empty();}
+
+		/** Returns the size of the allocated storage. */
+		size_type capacity() const noexcept {return _tape.capacity();}
+
+		/** Returns the number of free bytes before the first byte. */
+		size_type capacity_before() const noexcept {return _tape.capacity_before();}
+
+		/** Returns the number of free bytes after the last byte. */
+		size_type capacity_after() const noexcept {return _tape.capacity_after();}
+
+		/** Requests the storage to fit the buffered bytes. */
+		void shrink_to_fit() {_tape.shrink_to_fit();}
+
+		/** @} */
+
+		/**
+		 * \name Element access
+		 * @{
+		 */
+
+		/** Returns a pointer to the first byte. */
+		pointer data() noexcept {return _tape.data();}
+		const_pointer data() const noexcept {return _tape.data();}
+
+		iterator begin() noexcept {return _tape.begin();}
+		const_iterator begin() const noexcept {return _tape.begin();}
+		iterator end() noexcept {return _tape.end();}
+		const_iterator end() const noexcept {return _tape.end();}
+
+		/** @} */
+
+		/**
+		 * \name Modifiers
+		 * @{
+		 */
+
+		/** Makes room for at least n bytes after the last one.
+		 * Bytes are moved to the begining of the storage when it moves fewer bytes than it frees, the storage is reallocated otherwise.
+		 * \return Pointer to the first free byte, to be written then adopted with commit().
+		 */
+		pointer prepare(size_type n)
+		{
+			if(_tape.capacity_after() < n)
+			{
+				size_type free = _tape.capacity() - _tape.size();
+				if(free >= n && _tape.size() <= _tape.capacity_before())
+					_tape.recenter(0);
+			}
+			return _tape.grow_back_uninitialized(n);
+		}
+
+		/** Adopts n bytes written after the last byte, following a call to prepare(). */
+		void commit(size_type n)
+		{
+			_tape.commit_back(n);
+		}
+
+		/** Appends n bytes at the end of the buffer. */
+		void append(const void* bytes, size_type n)
+		{
+			if(n > 0)
+			{
+				std::memcpy(prepare(n), bytes, n);
+				commit(n);
+			}
+		}
+
+		/** Prepends n bytes at the begining of the buffer, without moving buffered bytes if there is enough room before them. */
+		void prepend(const void* bytes, size_type n)
+		{
+			if(n > 0)
+			{
+				std::memcpy(_tape.grow_front_uninitialized(n), bytes, n);
+				_tape.commit_front(n);
+			}
+		}
+
+		/** Removes the first n bytes of the buffer, in constant time.
+		 * When the buffer gets empty, next bytes are stored from the begining of the storage.
+		 */
+		void consume(size_type n)
+		{
+			_tape.pop_front(n);
+			if(_tape.empty())
+				_tape.recenter(0);
+		}
+
+		/** Removes all bytes of the buffer, keeping its storage. */
+		void clear() noexcept
+		{
+			_tape.pop_front(_tape.size());
+			_tape.recenter(0);
+		}
+
+		/** Exchanges the content of the buffer with another one. */
+		void swap(basic_byte_tape& other)
+		{
+			_tape.swap(other._tape);
+		}
+
+		/** @} */
+
+		/**
+		 * \name Input/output
+		 * @{
+		 */
+
+		/** Reads from a file descriptor and appends read bytes to the buffer.
+		 * Bytes are read with readv(2), directly into the slack after the last byte, which is grown to at least hint bytes.
+		 * Bytes which do not fit are read in a stack buffer of extra_read_size bytes, and then appended.
+		 * So a single call can drain most of a socket receive buffer, without growing the storage in advance.
+		 * \return Number of bytes read, 0 at end of file, or -1 on error with errno set by readv(2).
+		 */
+		ssize_t read_from(int fd, size_type hint = 4096)
+		{
+			char extra[extra_read_size];
+
+			struct iovec iov[2];
+			iov[0].iov_base = prepare(hint);
+			iov[0].iov_len  = _tape.capacity_after();
+			iov[1].iov_base = extra;
+			iov[1].iov_len  = sizeof(extra);
+
+			ssize_t res = ::readv(fd, iov, 2);
+			if(res > 0)
+			{
+				size_type n = (size_type)res;
+				if(n <= iov[0].iov_len)
+					commit(n);
+				else
+				{
+					commit(iov[0].iov_len);
+					append(extra, n - iov[0].iov_len);
+				}
+			}
+			return res;
+		}
+
+		/** Writes buffered bytes, from the first one, to a file descriptor, and consumes the written bytes.
+		 * Buffered bytes are contiguous, so they are written with a single write(2), even when only partially written.
+		 * \param max Maximal number of bytes to write.
+		 * \return Number of bytes written, or -1 on error with errno set by write(2).
+		 */
+		ssize_t write_to(int fd, size_type max = (size_type)-1)
+		{
+			size_type n = _tape.size() < max ? _tape.size() : max;
+			ssize_t res = ::write(fd, _tape.data(), n);
+			if(res > 0)
+				consume((size_type)res);
+			return res;
+		}
+
+		/** @} */
+	};
+
+	template <typename Allocator>
+	const typename basic_byte_tape<Allocator>::size_type basic_byte_tape<Allocator>::extra_read_size;
+
+	template <typename Allocator>
+	inline void swap(basic_byte_tape<Allocator>& x, basic_byte_tape<Allocator>& y)
+	{  x.swap(y);  }
+
+	/** Byte tape with default allocator. */
+	typedef basic_byte_tape<> byte_tape;
+
+} // namespace container
+
+#endif // CPPCONTAINERS_BYTE_TAPE_HPP
@@ -0,0 +1,356 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_CONCURRENT_TAPE_HPP
+#define CPPCONTAINERS_CONCURRENT_TAPE_HPP
+
+#include "tape.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace container
+{
+
+	/**
+	 * Concurrent tape is a tape appended and consumed from the front by a single writer, while any number of readers
+	 * iterate immutable snapshots of it, without locks.
+	 *
+	 * Elements are stored in a buffer, a tape whose storage is reserved in advance and is never reallocated.
+	 * The writer constructs new elements after the last published one, then publishes the new end of the range.
+	 * Removing elements from the front only publishes a new begining of the range, removed elements stay alive
+	 * as long as their buffer, so readers still iterating them are not disturbed.
+	 * When the buffer is full, remaining elements are copied to a new, larger, buffer which is then published.
+	 * Popped elements are not copied, so growth also reclaims front slack.
+	 *
+	 * Old buffers are retired and reclaimed by epochs: a reader announces the current epoch in a reader record
+	 * when taking a snapshot and clears it when releasing the snapshot.
+	 * A buffer retired at epoch E is freed once no snapshot is pinned at an epoch lower than or equal to E.
+	 *
+	 * Taking a snapshot is lock-free and iterating it is wait-free: readers never wait for the writer, even when it grows.
+	 * Writer functions (push_back, emplace_back, pop_front, clear, reserve and reclaim) must not be called concurrently,
+	 * but may be called concurrently with readers.
+	 * All snapshots must be released before the concurrent tape is destroyed.
+	 *
+	 * \tparam T Type of the elements, which must be copy constructible. Aliased as member type concurrent_tape::value_type.
+	 * \tparam Allocator Type of the allocator object used to allocate buffers elements. Aliased as member type concurrent_tape::allocator_type.
+	 */
+	template <typename T, typename Allocator = std::allocator<T> >
+	class concurrent_tape
+	{
+	public:
+		typedef tape<T, Allocator>							tape_type;			//!< The type of buffers.
+		typedef T											value_type;			//!< The type of elements.
+		typedef Allocator									allocator_type;		//!< The type of allocator used for buffers.
+		typedef std::size_t									size_type;			//!< Unsigned integral type, usually same as size_t.
+		typedef const value_type&							const_reference;	//!< Reference to a const element.
+		typedef const value_type*							const_pointer;		//!< Pointer to a const element.
+		typedef const value_type*							const_iterator;		//!< Random access iterator to const elements.
+
+		/** Minimal number of elements of buffers. */
+		static const size_type min_capacity = 16;
+
+	protected:
+		/** Storage of elements, published to readers. */
+		struct buffer
+		{
+			tape_type				elements;
+			const value_type*		data;	// Storage of elements, never reallocated.
+			std::atomic<size_type>	first;	// Index of first published element.
+			std::atomic<size_type>	last;	// Index following the last published element.
+
+			explicit buffer(const allocator_type& alloc):elements(alloc), data(nullptr), first(0), last(0) {}
+		};
+
+		/** Epoch announced by a reader, records are reused by following snapshots and only freed with the concurrent tape. */
+		struct reader_record
+		{
+			std::atomic<std::uint64_t>	epoch;	// Epoch pinned by the snapshot using the record, 0 when none.
+			std::atomic<bool>			used;	// Record is owned by a snapshot.
+			reader_record*				next;
+
+			reader_record():epoch(0), used(true), next(nullptr) {}
+		};
+
+		/** Buffer waiting for readers pinned at its retirement epoch or before. */
+		struct retired_buffer
+		{
+			buffer*			buf;
+			std::uint64_t	epoch;
+		};
+
+		allocator_type					_alloc;
+		std::atomic<buffer*>			_current;	// Published buffer.
+		std::atomic<std::uint64_t>		_epoch;		// Current epoch, starting at 1.
+		mutable std::atomic<reader_record*>	_readers;	// List of reader records.
+		std::vector<retired_buffer>		_retired;	// Retired buffers, only accessed by the writer.
+
+	public:
+		/**
+		 * Immutable view of the elements published when it was taken.
+		 * The snapshot keeps their buffer alive until it is released, when destroyed or assigned.
+		 */
+		class snapshot
+		{
+		public:
+			/** Constructs an empty snapshot, not bound to any concurrent tape. */
+			snapshot() noexcept:_record(nullptr), _first(nullptr), _last(nullptr) {}
+
+			snapshot(snapshot&& other) noexcept:
+			_record(other._record), _first(other._first), _last(other._last)
+			{
+				other._record = nullptr;
+				other._first = other._last = nullptr;
+			}
+
+			snapshot& operator=(snapshot&& other) noexcept
+			{
+				if(this != &other)
+				{
+					release();
+					std::swap(_record, other._record);
+					std::swap(_first, other._first);
+					std::swap(_last, other._last);
+				}
+				return *this;
+			}
+
+			snapshot(const snapshot&) = delete;
+			snapshot& operator=(const snapshot&) = delete;
+
+			~snapshot() {release();}
+
+			/** Releases the snapshot, which becomes empty. Its buffer can then be reclaimed. */
+			void release() noexcept
+			{
+				if(_record)
+				{
+					_record->epoch.store(0, std::memory_order_release);
+					_record->used.store(false, std::memory_order_release);
+					_record = nullptr;
+				}
+				_first = _last = nullptr;
+			}
+
+			const_iterator begin() const noexcept {return _first;}
+			const_iterator end() const noexcept {return _last;}
+			const_iterator cbegin() const noexcept {return _first;}
+			const_iterator cend() const noexcept {return _last;}
+
+			/** Returns the number of elements in the snapshot. */
+			size_type size() const noexcept {return _last - _first;}
+
+			/** Tells if the snapshot is empty. */
+			bool empty() const noexcept {return _first == _last;}
+
+			/** Returns a reference to the element at position n, without bound checking. */
+			const_reference operator[](size_type n) const {return _first[n];}
+
+			/** Returns a reference to the first element. */
+			const_reference front() const {return *_first;}
+
+			/** Returns a reference to the last element. */
+			const_reference back() const {return *(_last - 1);}
+
+			/** Returns a pointer to the first element. */
+			const_pointer data() const noexcept {return _first;}
+
+		private:
+			friend class concurrent_tape;
+
+			snapshot(reader_record* record, const_pointer first, const_pointer last) noexcept:
+			_record(record), _first(first), _last(last)
+			{}
+
+			reader_record*	_record;
+			const_pointer	_first;
+			const_pointer	_last;
+		};
+
+		/** Constructs an empty concurrent tape. */
+		explicit concurrent_tape(const allocator_type& alloc = allocator_type()):
+		_alloc(alloc), _current(nullptr), _epoch(1), _readers(nullptr)
+		{
+			std::unique_ptr<buffer> buf(new buffer(_alloc));
+			buf->elements.reserve_after(min_capacity);
+			buf->data = buf->elements.data();
+			_current.store(buf.release(), std::memory_order_release);
+		}
+
+		concurrent_tape(const concurrent_tape&) = delete;
+		concurrent_tape& operator=(const concurrent_tape&) = delete;
+
+		/** Destroys the concurrent tape, no snapshot must still be alive. */
+		~concurrent_tape()
+		{
+			for(size_type i = 0; i < _retired.size(); ++i)
+				delete _retired[i].buf;
+			delete _current.load(std::memory_order_relaxed);
+			reader_record* rec = _readers.load(std::memory_order_relaxed);
+			while(rec)
+			{
+				reader_record* next = rec->next;
+				delete rec;
+				rec = next;
+			}
+		}
+
+		/**
+		 * \name Readers
+		 * Functions which can be called concurrently from any thread.
+		 * @{
+		 */
+
+		/** Takes a snapshot of the elements published so far. */
+		snapshot read() const
+		{
+			reader_record* rec = _acquire_record();
+			rec->epoch.store(_epoch.load());
+			buffer* buf = _current.load();
+			// First is loaded before last, elements only being published after and removed before them.
+			size_type first = buf->first.load(std::memory_order_acquire);
+			size_type last = buf->last.load(std::memory_order_acquire);
+			return snapshot(rec, buf->data + first, buf->data + last);
+		}
+
+		/** Returns the number of published elements, which may already have changed when returning. */
+		size_type size() const
+		{
+			return read().size();
+		}
+
+		/** @} */
+
+		/**
+		 * \name Writer
+		 * Functions which must not be called concurrently to each others.
+		 * @{
+		 */
+
+		/** Adds a copy of val after the last element and publishes it. */
+		void push_back(const value_type& val) {emplace_back(val);}
+
+		/** Adds val after the last element, moving it, and publishes it. */
+		void push_back(value_type&& val) {emplace_back(std::move(val));}
+
+		/** Constructs an element in place after the last element and publishes it. */
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			buffer* buf = _current.load(std::memory_order_relaxed);
+			if(buf->elements.capacity_after() == 0)
+				buf = _grow(1);
+			buf->elements.emplace_back(std::forward<Args>(args)...);
+			buf->last.store(buf->elements.size(), std::memory_order_release);
+		}
+
+		/** Removes the first n elements, or all of them if there are fewer, from the published range.
+		 * They are destroyed when their buffer is reclaimed.
+		 */
+		void pop_front(size_type n = 1)
+		{
+			buffer* buf = _current.load(std::memory_order_relaxed);
+			size_type first = buf->first.load(std::memory_order_relaxed);
+			size_type last = buf->last.load(std::memory_order_relaxed);
+			buf->first.store(first + std::min(n, last - first), std::memory_order_release);
+		}
+
+		/** Removes all elements from the published range. */
+		void clear()
+		{
+			buffer* buf = _current.load(std::memory_order_relaxed);
+			buf->first.store(buf->last.load(std::memory_order_relaxed), std::memory_order_release);
+		}
+
+		/** Makes room for at least n elements after the last one, moving to a new buffer if needed. */
+		void reserve(size_type n)
+		{
+			if(_current.load(std::memory_order_relaxed)->elements.capacity_after() < n)
+				_grow(n);
+		}
+
+		/** Frees retired buffers which are no longer used by any snapshot.
+		 * This is done on each growth, calling it reclaims buffers as soon as snapshots are released.
+		 * \return Number of retired buffers still waiting for snapshots.
+		 */
+		size_type reclaim()
+		{
+			std::uint64_t pinned = 0;
+			for(reader_record* rec = _readers.load(); rec; rec = rec->next)
+			{
+				std::uint64_t epoch = rec->epoch.load();
+				if(epoch != 0 && (pinned == 0 || epoch < pinned))
+					pinned = epoch;
+			}
+			size_type kept = 0;
+			for(size_type i = 0; i < _retired.size(); ++i)
+			{
+				if(pinned != 0 && _retired[i].epoch >= pinned)
+					_retired[kept++] = _retired[i];
+				else
+					delete _retired[i].buf;
+			}
+			_retired.resize(kept);
+			return kept;
+		}
+
+		/** @} */
+
+	protected:
+		/** Copies the published elements to a new buffer with room for n more, publishes it and retires the previous one. */
+		CONTAINER_TAPE_NOINLINE buffer* _grow(size_type n)
+		{
+			buffer* old = _current.load(std::memory_order_relaxed);
+			const value_type* first = old->data + old->first.load(std::memory_order_relaxed);
+			const value_type* last = old->data + old->last.load(std::memory_order_relaxed);
+			size_type count = last - first;
+
+			// Elements are copied: readers may still be reading the old ones
+			std::unique_ptr<buffer> buf(new buffer(_alloc));
+			buf->elements.reserve_after(std::max(std::max(2 * count, count + n), (size_type)min_capacity));
+			buf->elements.push_back(first, last);
+			buf->data = buf->elements.data();
+			buf->last.store(count, std::memory_order_relaxed);
+
+			_retired.reserve(_retired.size() + 1);
+			_current.store(buf.get());
+			_retired.push_back(retired_buffer{old, _epoch.fetch_add(1)});
+			reclaim();
+			return buf.release();
+		}
+
+		/** Takes an unused reader record, or creates a new one. */
+		reader_record* _acquire_record() const
+		{
+			for(reader_record* rec = _readers.load(std::memory_order_acquire); rec; rec = rec->next)
+			{
+				bool used = false;
+				if(!rec->used.load(std::memory_order_relaxed) && rec->used.compare_exchange_strong(used, true, std::memory_order_acquire))
+					return rec;
+			}
+			reader_record* rec = new reader_record;
+			reader_record* head = _readers.load(std::memory_order_relaxed);
+			// Sequentially consistent like the epoch announcement following it: once the reader sees the current buffer,
+			// the writer retiring that buffer sees the record in reclaim().
+			do
+			{
+				rec->next = head;
+			}
+			while(!_readers.compare_exchange_weak(head, rec, std::memory_order_seq_cst, std::memory_order_relaxed));
+			return rec;
+		}
+	};
+
+} // namespace container
+
+#endif // CPPCONTAINERS_CONCURRENT_TAPE_HPP
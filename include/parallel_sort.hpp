@@ -0,0 +1,257 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_PARALLEL_SORT_HPP
+#define CPPCONTAINERS_PARALLEL_SORT_HPP
+
+#include "tape.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace container
+{
+
+	/**
+	 * Parallel sort implementation details.
+	 */
+	namespace parallel
+	{
+
+		/** Below this number of elements per thread, less threads are used. */
+		const std::size_t min_chunk = 4096;
+
+		/** Call fn(0) .. fn(count-1) concurrently, fn(0) in the calling thread.
+		 * If a thread cannot be started, for example under a limit of threads, the calls left are done in the calling thread.
+		 * The first exception thrown by a call is rethrown once all calls are done.
+		 */
+		template <typename Fn>
+		void run(std::size_t count, Fn fn)
+		{
+			std::vector<std::exception_ptr> errors(count);
+			std::vector<std::thread> workers;
+			workers.reserve(count);
+			std::size_t started = 1; // Calls from started are done in the calling thread
+			for(; started < count; ++started)
+			{
+				std::size_t i = started;
+				try
+				{
+					workers.push_back(std::thread([&fn, &errors, i](){
+						try {fn(i);}
+						catch(...) {errors[i] = std::current_exception();}
+					}));
+				}
+				catch(const std::system_error&)
+				{
+					break;
+				}
+			}
+			try {fn(0);}
+			catch(...) {errors[0] = std::current_exception();}
+			for(std::size_t i = started; i < count; ++i)
+			{
+				try {fn(i);}
+				catch(...) {errors[i] = std::current_exception();}
+			}
+			for(std::size_t i = 0; i < workers.size(); ++i)
+				workers[i].join();
+			for(std::size_t i = 0; i < count; ++i)
+				if(errors[i])
+					std::rethrow_exception(errors[i]);
+		}
+
+		/** Number of elements of a taken among the first k elements of the merge of sorted ranges a and b, as done by std::merge (merge path). */
+		template <typename T, typename Compare>
+		std::size_t co_rank(std::size_t k, const T* a, std::size_t na, const T* b, std::size_t nb, Compare& comp)
+		{
+			std::size_t lo = k > nb ? k - nb : 0;
+			std::size_t hi = k < na ? k : na;
+			while(lo < hi)
+			{
+				std::size_t i = lo + (hi - lo) / 2;
+				// std::merge takes a[i] before b[k-i-1] unless b[k-i-1] is less: then more elements of a are needed.
+				if(!comp(b[k - i - 1], a[i]))
+					lo = i + 1;
+				else
+					hi = i;
+			}
+			return lo;
+		}
+
+		/** Part of the merge of two sorted runs, [a_first, a_last) and [b_first, b_last) of source, into dst from out. */
+		struct merge_task
+		{
+			std::size_t a_first, a_last;
+			std::size_t b_first, b_last;
+			std::size_t out;
+		};
+
+		/** Runs merge tasks from src into the uninitialized storage dst with count threads, elements being move constructed with alloc.
+		 * If a comparison or a move throws, the elements constructed in dst are destroyed and the exception is rethrown.
+		 */
+		template <typename Allocator, typename T, typename Compare>
+		void merge_uninitialized(Allocator& alloc, const std::vector<merge_task>& tasks, T* src, T* dst, std::size_t count, Compare& comp)
+		{
+			typedef std::allocator_traits<Allocator> traits;
+			std::vector<std::size_t> done(tasks.size(), 0); // Elements constructed by each task
+			try
+			{
+				run(std::min<std::size_t>(count, tasks.size()), [&](std::size_t i){
+					for(std::size_t k = i; k < tasks.size(); k += count)
+					{
+						const merge_task& task = tasks[k];
+						T* a = src + task.a_first;
+						T* b = src + task.b_first;
+						T* out = dst + task.out;
+						std::size_t& c = done[k];
+						// Like std::merge, an element of a is taken before an equivalent element of b
+						for(; a != src + task.a_last && b != src + task.b_last; ++c)
+							traits::construct(alloc, out + c, std::move(comp(*b, *a) ? *b++ : *a++));
+						for(; a != src + task.a_last; ++c)
+							traits::construct(alloc, out + c, std::move(*a++));
+						for(; b != src + task.b_last; ++c)
+							traits::construct(alloc, out + c, std::move(*b++));
+					}
+				});
+			}
+			catch(...)
+			{
+				for(std::size_t k = 0; k < tasks.size(); ++k)
+					for(std::size_t c = 0; c < done[k]; ++c)
+						traits::destroy(alloc, dst + tasks[k].out + c);
+				throw;
+			}
+		}
+
+	} // namespace parallel
+
+	/**
+	 * Sorts the elements of a tape with several threads.
+	 *
+	 * Elements are split in one chunk per thread, each chunk is sorted in place with std::sort,
+	 * then sorted runs are merged pairwise until only one is left.
+	 * Every merge is itself split in parts of equal size (merge path), so all threads work in every round.
+	 * Merges ping-pong between the tape and a scratch tape of the same size,
+	 * the first round constructing the elements of the scratch tape, so no sequential pass copies the tape.
+	 *
+	 * Like std::sort, the order of equivalent elements is not preserved.
+	 * If the comparator or a move of elements throws, the exception is rethrown once all threads are done, the tape content is then unspecified.
+	 *
+	 * \param comp Strict weak ordering of elements, called concurrently.
+	 * \param threads Number of threads to use, hardware concurrency if 0.
+	 */
+	template <typename T, typename Allocator, typename Stats, typename Shrink, typename Compare>
+	void parallel_sort(tape<T, Allocator, Stats, Shrink>& t, Compare comp, unsigned threads = 0)
+	{
+		std::size_t n = t.size();
+		if(threads == 0)
+			threads = std::thread::hardware_concurrency();
+		std::size_t count = std::min<std::size_t>(threads, n / parallel::min_chunk);
+		if(count <= 1)
+		{
+			std::sort(t.begin(), t.end(), comp);
+			return;
+		}
+
+		// Sort chunks in place
+		T* data = t.data();
+		std::vector<std::size_t> runs(count + 1);
+		for(std::size_t i = 0; i <= count; ++i)
+			runs[i] = n * i / count;
+		parallel::run(count, [&](std::size_t i){
+			std::sort(data + runs[i], data + runs[i + 1], comp);
+		});
+
+		// Merge runs pairwise, each merge being split between threads in proportion of its size.
+		// The first round merges from the tape into the uninitialized scratch tape, then elements are merged back and forth.
+		Allocator alloc = t.get_allocator();
+		tape<T, Allocator> scratch(alloc);
+		T* src = data;
+		T* dst = scratch.grow_back_uninitialized(n);
+		bool constructed = false;
+		while(runs.size() > 2)
+		{
+			std::vector<parallel::merge_task> tasks;
+			std::vector<std::size_t> merged;
+			for(std::size_t r = 0; r + 1 < runs.size(); r += 2)
+			{
+				// A last run without pair is just moved
+				std::size_t first = runs[r], middle = runs[r + 1];
+				std::size_t last = r + 2 < runs.size() ? runs[r + 2] : middle;
+				std::size_t na = middle - first, nb = last - middle;
+				std::size_t size = na + nb;
+				std::size_t parts = std::max<std::size_t>(1, count * size / n);
+				// Split points are found before merging, as merges move elements out of source
+				std::size_t ia = 0;
+				for(std::size_t p = 1; p <= parts; ++p)
+				{
+					std::size_t k = size * p / parts;
+					std::size_t ja = p == parts ? na : parallel::co_rank(k, src + first, na, src + middle, nb, comp);
+					std::size_t begin = size * (p - 1) / parts;
+					parallel::merge_task task = {first + ia, first + ja, middle + begin - ia, middle + k - ja, first + begin};
+					tasks.push_back(task);
+					ia = ja;
+				}
+				merged.push_back(runs[r]);
+			}
+			merged.push_back(n);
+
+			if(!constructed)
+			{
+				parallel::merge_uninitialized(alloc, tasks, src, dst, count, comp);
+				scratch.commit_back(n);
+				constructed = true;
+			}
+			else
+			{
+				parallel::run(std::min<std::size_t>(count, tasks.size()), [&](std::size_t i){
+					for(std::size_t k = i; k < tasks.size(); k += count)
+					{
+						const parallel::merge_task& task = tasks[k];
+						std::merge(std::make_move_iterator(src + task.a_first), std::make_move_iterator(src + task.a_last),
+							std::make_move_iterator(src + task.b_first), std::make_move_iterator(src + task.b_last),
+							dst + task.out, comp);
+					}
+				});
+			}
+
+			runs.swap(merged);
+			std::swap(src, dst);
+		}
+
+		// Move back sorted elements in the tape
+		if(src != data)
+		{
+			parallel::run(count, [&](std::size_t i){
+				std::move(src + n * i / count, src + n * (i + 1) / count, data + n * i / count);
+			});
+		}
+	}
+
+	/**
+	 * Sorts the elements of a tape in ascending order with several threads.
+	 * \see parallel_sort(tape&, Compare, unsigned)
+	 */
+	template <typename T, typename Allocator, typename Stats, typename Shrink>
+	void parallel_sort(tape<T, Allocator, Stats, Shrink>& t, unsigned threads = 0)
+	{
+		parallel_sort(t, std::less<T>(), threads);
+	}
+
+} // namespace container
+
+#endif // CPPCONTAINERS_PARALLEL_SORT_HPP
@@ -0,0 +1,203 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_RADIX_SORT_HPP
+#define CPPCONTAINERS_RADIX_SORT_HPP
+
+#include "tape.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+namespace container
+{
+
+	/**
+	 * Radix sort implementation details.
+	 */
+	namespace radix
+	{
+
+		/** Unsigned integer of N bytes, in which radix keys are encoded. */
+		template <std::size_t N> struct unsigned_of;
+		template <> struct unsigned_of<1> {typedef std::uint8_t  type;};
+		template <> struct unsigned_of<2> {typedef std::uint16_t type;};
+		template <> struct unsigned_of<4> {typedef std::uint32_t type;};
+		template <> struct unsigned_of<8> {typedef std::uint64_t type;};
+
+		/**
+		 * Encoding of a sort key as an unsigned integer, whose order is the order of the key.
+		 * - unsigned integers are kept as is,
+		 * - signed integers get their sign bit flipped,
+		 * - floating point numbers get their sign bit flipped when positive, and all their bits flipped when negative.
+		 *   So -0.0 is sorted before +0.0, and NaNs are sorted after +infinity or before -infinity depending on their sign bit.
+		 */
+		template <typename K, typename Enable = void> struct key_traits;
+
+		template <typename K>
+		struct key_traits<K, typename std::enable_if<std::is_integral<K>::value>::type>
+		{
+			typedef typename unsigned_of<sizeof(K)>::type type;
+			static type encode(K key)
+			{
+				type bits = (type)key;
+				if(std::is_signed<K>::value)
+					bits ^= (type)((type)1 << (sizeof(K) * 8 - 1));
+				return bits;
+			}
+		};
+
+		template <typename K>
+		struct key_traits<K, typename std::enable_if<std::is_floating_point<K>::value>::type>
+		{
+			static_assert(std::numeric_limits<K>::is_iec559, "radix sort of floating point numbers requires IEEE 754 representation");
+			typedef typename unsigned_of<sizeof(K)>::type type;
+			static type encode(K key)
+			{
+				type bits;
+				std::memcpy(&bits, &key, sizeof(K));
+				const type sign = (type)((type)1 << (sizeof(K) * 8 - 1));
+				return (bits & sign) ? (type)~bits : (type)(bits | sign);
+			}
+		};
+
+		/** Key extractor returning the element itself. */
+		struct identity
+		{
+			template <typename T>
+			const T& operator()(const T& value) const {return value;}
+		};
+
+		/**
+		 * LSD radix sort of [first, first+n), one byte per pass, using buffer as ping-pong storage of n elements.
+		 * Histograms of all bytes are computed in a single read of the data before the passes.
+		 * Passes where all keys share the same byte are skipped.
+		 * \return true if sorted elements are in buffer, false if they are in first.
+		 */
+		template <typename T, typename KeyFn>
+		bool sort(T* first, T* buffer, std::size_t n, KeyFn key)
+		{
+			typedef typename std::decay<decltype(key(*first))>::type key_type;
+			typedef key_traits<key_type> traits;
+			typedef typename traits::type bits_type;
+			const std::size_t passes = sizeof(bits_type);
+
+			std::size_t counts[passes][256];
+			std::memset(counts, 0, sizeof(counts));
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				bits_type bits = traits::encode(key(first[i]));
+				for(std::size_t p = 0; p < passes; ++p)
+					++counts[p][(bits >> (8 * p)) & 0xFF];
+			}
+
+			T* src = first;
+			T* dst = buffer;
+			for(std::size_t p = 0; p < passes; ++p)
+			{
+				// Skip pass if all keys have the same byte
+				std::size_t* count = counts[p];
+				bits_type byte = (traits::encode(key(first[0])) >> (8 * p)) & 0xFF;
+				if(count[byte] == n)
+					continue;
+
+				// Count to offsets
+				std::size_t offset = 0;
+				for(std::size_t b = 0; b < 256; ++b)
+				{
+					std::size_t c = count[b];
+					count[b] = offset;
+					offset += c;
+				}
+
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					const T& value = src[i];
+					dst[count[(traits::encode(key(value)) >> (8 * p)) & 0xFF]++] = value;
+				}
+				std::swap(src, dst);
+			}
+			return src != first;
+		}
+
+		/** Stable insertion sort by key, for small ranges. */
+		template <typename T, typename KeyFn>
+		void insertion_sort(T* first, std::size_t n, KeyFn key)
+		{
+			typedef typename std::decay<decltype(key(*first))>::type key_type;
+			typedef key_traits<key_type> traits;
+			for(std::size_t i = 1; i < n; ++i)
+			{
+				T value = first[i];
+				typename traits::type bits = traits::encode(key(value));
+				std::size_t j = i;
+				for(; j > 0 && bits < traits::encode(key(first[j - 1])); --j)
+					first[j] = first[j - 1];
+				first[j] = value;
+			}
+		}
+
+		/** Below this size, ranges are sorted by insertion. */
+		const std::size_t insertion_threshold = 32;
+
+	} // namespace radix
+
+	/**
+	 * Sorts the elements of a tape by a key extracted from each element, with a stable LSD radix sort.
+	 *
+	 * Keys are integral or floating point numbers. Sorting takes one pass per byte of key, passes where all keys share the same byte are skipped.
+	 * The ping-pong buffer of the passes is the slack of the tape when it has room for all elements before or after them,
+	 * otherwise a scratch tape is allocated.
+	 *
+	 * \tparam T Trivial type of the elements, they are copied bytewise between passes.
+	 * \param key Callable returning the key of an element.
+	 */
+	template <typename T, typename Allocator, typename Stats, typename Shrink, typename KeyFn>
+	void radix_sort(tape<T, Allocator, Stats, Shrink>& t, KeyFn key)
+	{
+		static_assert(std::is_trivial<T>::value, "radix sort requires a trivial value type");
+
+		std::size_t n = t.size();
+		T* first = t.data();
+		if(n <= radix::insertion_threshold)
+		{
+			radix::insertion_sort(first, n, key);
+			return;
+		}
+
+		// Use the tape slack as buffer, or a scratch tape
+		T* buffer;
+		tape<T, Allocator> scratch(t.get_allocator());
+		if(t.capacity_before() >= n)
+			buffer = first - n;
+		else if(t.capacity_after() >= n)
+			buffer = first + n;
+		else
+			buffer = scratch.grow_back_uninitialized(n);
+
+		if(radix::sort(first, buffer, n, key))
+			std::memcpy(first, buffer, n * sizeof(T));
+	}
+
+	/**
+	 * Sorts the elements of a tape of integral or floating point numbers, with a stable LSD radix sort.
+	 * \see radix_sort(tape&, KeyFn)
+	 */
+	template <typename T, typename Allocator, typename Stats, typename Shrink>
+	void radix_sort(tape<T, Allocator, Stats, Shrink>& t)
+	{
+		radix_sort(t, radix::identity());
+	}
+
+} // namespace container
+
+#endif // CPPCONTAINERS_RADIX_SORT_HPP
@@ -0,0 +1,205 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_REVERSE_ENCODER_HPP
+#define CPPCONTAINERS_REVERSE_ENCODER_HPP
+
+#include "tape.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace container
+{
+
+	/**
+	 * Reverse encoder serializes length-prefixed binary messages (protobuf-like, ASN.1 TLV) in a single pass.
+	 *
+	 * Message is written from its end to its begining: every put_xxx() prepends its bytes to the encoded data.
+	 * So the content of a nested message is written first, then its length and tag are prepended,
+	 * without computing its size beforehand nor moving it afterwards:
+	 *
+	 *     size_t end = enc.mark();
+	 *     enc.put_varint(y);           // Last field of the nested message
+	 *     enc.put_tag(2, reverse_encoder::varint_type);
+	 *     enc.put_varint(x);           // First field of the nested message
+	 *     enc.put_tag(1, reverse_encoder::varint_type);
+	 *     enc.put_length(end);         // Length of the nested message
+	 *     enc.put_tag(3, reverse_encoder::length_type);
+	 *
+	 * Encoded data are stored in a tape of bytes, growing at its front, and are contiguous once encoding is done.
+	 * Varints are LEB128 (7 bits per byte, least significant first), fixed-size integers are little-endian.
+	 */
+	class reverse_encoder
+	{
+	public:
+		typedef tape<std::uint8_t>			tape_type;		//!< The type of tape storing encoded data.
+		typedef tape_type::size_type		size_type;		//!< Unsigned integral type, usually same as size_t.
+
+		/** Protobuf wire types, lowest 3 bits of field tags. */
+		enum wire_type
+		{
+			varint_type  = 0,	//!< Varint.
+			fixed64_type = 1,	//!< 64-bit little-endian.
+			length_type  = 2,	//!< Length-delimited: bytes, strings and nested messages.
+			fixed32_type = 5	//!< 32-bit little-endian.
+		};
+
+		/** Maximal size of a 64-bit varint. */
+		enum {max_varint_size = 10};
+
+	protected:
+		tape_type _tape;
+
+	public:
+		/** Constructs an empty encoder, with room for capacity bytes before needing an allocation. */
+		explicit reverse_encoder(size_type capacity = 0)
+		{
+			if(capacity > 0)
+				_tape.reserve_before(capacity);
+		}
+
+		/** Returns the number of encoded bytes. */
+		size_type size() const noexcept {return _tape.size();}
+
+		/** Returns a pointer to the encoded bytes. */
+		const std::uint8_t* data() const noexcept {return _tape.data();}
+
+		/** Returns the tape of encoded bytes. */
+		const tape_type& get_tape() const noexcept {return _tape;}
+
+		/** Takes the tape of encoded bytes, leaving the encoder empty. */
+		tape_type release()
+		{
+			tape_type res(std::move(_tape));
+			_tape.clear();
+			return res;
+		}
+
+		/** Removes all encoded bytes, keeping storage for the next message. */
+		void clear() noexcept {_tape.clear();}
+
+		/** Returns a mark of the current position, to compute the length of data encoded after it with put_length().
+		 * As data are prepended, the mark is the count of bytes already encoded, which does not change when more are prepended.
+		 */
+		size_type mark() const noexcept {return _tape.size();}
+
+		/** Prepends a byte. */
+		void put_byte(std::uint8_t byte)
+		{
+			_tape.push_front(byte);
+		}
+
+		/** Prepends n bytes. */
+		void put_bytes(const void* bytes, size_type n)
+		{
+			if(n > 0)
+			{
+				std::memcpy(_tape.grow_front_uninitialized(n), bytes, n);
+				_tape.commit_front(n);
+			}
+		}
+
+		/** Prepends a varint. It is written directly in the free slots before the encoded data. */
+		void put_varint(std::uint64_t value)
+		{
+			size_type n = 1;
+			for(std::uint64_t v = value; v >= 0x80; v >>= 7)
+				++n;
+			std::uint8_t* p = _tape.grow_front_uninitialized(n);
+			for(; value >= 0x80; value >>= 7)
+				*p++ = (std::uint8_t)(value | 0x80);
+			*p = (std::uint8_t)value;
+			_tape.commit_front(n);
+		}
+
+		/** Prepends a signed varint, zigzag-encoded so small negative values stay short. */
+		void put_svarint(std::int64_t value)
+		{
+			put_varint(((std::uint64_t)value << 1) ^ (std::uint64_t)(value >> 63));
+		}
+
+		/** Prepends a 32-bit little-endian integer. */
+		void put_fixed32(std::uint32_t value)
+		{
+			std::uint8_t buffer[4];
+			for(int n = 0; n < 4; ++n)
+				buffer[n] = (std::uint8_t)(value >> (8 * n));
+			put_bytes(buffer, 4);
+		}
+
+		/** Prepends a 64-bit little-endian integer. */
+		void put_fixed64(std::uint64_t value)
+		{
+			std::uint8_t buffer[8];
+			for(int n = 0; n < 8; ++n)
+				buffer[n] = (std::uint8_t)(value >> (8 * n));
+			put_bytes(buffer, 8);
+		}
+
+		/** Prepends a protobuf field tag. */
+		void put_tag(std::uint32_t field, wire_type type)
+		{
+			put_varint(((std::uint64_t)field << 3) | type);
+		}
+
+		/** Prepends, as a varint, the number of bytes encoded since mark was taken. */
+		void put_length(size_type mark)
+		{
+			put_varint(_tape.size() - mark);
+		}
+
+		/** Prepends, as an ASN.1 DER length, the number of bytes encoded since mark was taken.
+		 * Lengths below 128 take one byte, others are big-endian and prefixed by their byte count ORed with 0x80.
+		 */
+		void put_der_length(size_type mark)
+		{
+			size_type length = _tape.size() - mark;
+			if(length < 0x80)
+			{
+				put_byte((std::uint8_t)length);
+				return;
+			}
+			std::uint8_t n = 0;
+			for(; length; length >>= 8, ++n)
+				put_byte((std::uint8_t)length);
+			put_byte(0x80 | n);
+		}
+
+		/** Prepends a varint field: its value then its tag. */
+		void put_varint_field(std::uint32_t field, std::uint64_t value)
+		{
+			put_varint(value);
+			put_tag(field, varint_type);
+		}
+
+		/** Prepends a length-delimited field: its bytes, their length and its tag. */
+		void put_bytes_field(std::uint32_t field, const void* bytes, size_type n)
+		{
+			put_bytes(bytes, n);
+			put_varint(n);
+			put_tag(field, length_type);
+		}
+
+		/** Prepends a nested message field.
+		 * \param fn Callable encoding the fields of the nested message, last field first.
+		 */
+		template<typename Fn>
+		void put_message_field(std::uint32_t field, Fn fn)
+		{
+			size_type end = mark();
+			fn(*this);
+			put_length(end);
+			put_tag(field, length_type);
+		}
+	};
+
+} // namespace container
+
+#endif // CPPCONTAINERS_REVERSE_ENCODER_HPP
@@ -0,0 +1,290 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_SHARDED_TAPE_HPP
+#define CPPCONTAINERS_SHARDED_TAPE_HPP
+
+#include "tape.hpp"
+#include "parallel_sort.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace container
+{
+
+	/**
+	 * Sharded tape gives each thread its own tape, a shard, to produce elements in parallel without synchronization,
+	 * and then collects all shards into a single tape, to be consumed sequentially.
+	 *
+	 * The shard of a thread is looked up in a registry protected by a mutex the first time the thread uses the sharded tape,
+	 * and then cached in a thread local variable, so following calls do not synchronize.
+	 *
+	 * collect() sizes the output tape once and moves the elements of all shards into it in parallel, leaving shards empty.
+	 * Without order preservation, shards are concatenated in the order threads first used the sharded tape.
+	 * With order preservation, each element is tagged with a sequence number, taken from a shared atomic counter
+	 * when it is pushed, and collected elements are sorted by tag: they come in the order they were pushed in.
+	 *
+	 * Pushing can be done concurrently from any threads, collect() must not be called concurrently with pushes.
+	 * When order is preserved, shards are only modified by push and emplace functions, local() then throws.
+	 *
+	 * \tparam T Type of the elements, move constructed in the collected tape. Aliased as member type sharded_tape::value_type.
+	 * \tparam Allocator Type of the allocator object used by shards, their tags and collected tape. Aliased as member type sharded_tape::allocator_type.
+	 */
+	template <typename T, typename Allocator = std::allocator<T> >
+	class sharded_tape
+	{
+	public:
+		typedef tape<T, Allocator>							tape_type;			//!< The type of shards and of collected tape.
+		typedef T											value_type;			//!< The type of elements.
+		typedef Allocator									allocator_type;		//!< The type of allocator used for shards.
+		typedef std::size_t									size_type;			//!< Unsigned integral type, usually same as size_t.
+
+	protected:
+		typedef tape<std::uint64_t, typename std::allocator_traits<allocator_type>::template rebind_alloc<std::uint64_t> >	tag_tape;
+
+		/** Elements produced by a thread, with their sequence tags when order is preserved. */
+		struct shard
+		{
+			tape_type					elements;
+			tag_tape					tags;
+			std::thread::id				owner;
+
+			shard(const allocator_type& alloc, std::thread::id owner):
+			elements(alloc), tags(typename tag_tape::allocator_type(alloc)), owner(owner) {}
+		};
+
+		/** Last shard used by a thread, with the identifier of its sharded tape. */
+		struct cache_entry
+		{
+			std::uint64_t	id;
+			shard*			s;
+		};
+
+		allocator_type						_alloc;
+		bool								_ordered;	// Elements are tagged with sequence numbers.
+		std::uint64_t						_id;		// Unique identifier, never reused unlike addresses.
+		std::atomic<std::uint64_t>			_sequence;	// Next sequence tag.
+		std::mutex							_mutex;		// Protects the registry of shards.
+		std::vector<std::unique_ptr<shard> >	_shards;
+
+	public:
+		/** Constructs an empty sharded tape.
+		 * \param ordered Preserve the order of pushes when collecting.
+		 * \param alloc Allocator sample of shards and collected tape.
+		 */
+		explicit sharded_tape(bool ordered = false, const allocator_type& alloc = allocator_type()):
+		_alloc(alloc), _ordered(ordered), _id(_next_id()), _sequence(0)
+		{}
+
+		sharded_tape(const sharded_tape&) = delete;
+		sharded_tape& operator=(const sharded_tape&) = delete;
+
+		/** Tells if the order of pushes is preserved when collecting. */
+		bool ordered() const noexcept {return _ordered;}
+
+		/** Returns the number of shards, one per thread which used the sharded tape. */
+		size_type shards()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _shards.size();
+		}
+
+		/** Returns the number of elements of all shards. Must not be called concurrently with pushes. */
+		size_type size()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			size_type n = 0;
+			for(size_type i = 0; i < _shards.size(); ++i)
+				n += _shards[i]->elements.size();
+			return n;
+		}
+
+		/** Returns the shard of the calling thread, to be used directly.
+		 * \throw std::logic_error if order is preserved: elements added to the shard directly would have no sequence tag.
+		 */
+		tape_type& local()
+		{
+			if(_ordered)
+				throw std::logic_error("sharded_tape::local");
+			return _local().elements;
+		}
+
+		/**
+		 * \name Producers
+		 * Functions which can be called concurrently from any thread, each modifying the shard of the calling thread.
+		 * @{
+		 */
+
+		/** Adds a copy of val after the last element of the shard. */
+		void push_back(const value_type& val) {emplace_back(val);}
+
+		/** Adds val after the last element of the shard, moving it. */
+		void push_back(value_type&& val) {emplace_back(std::move(val));}
+
+		/** Constructs an element in place after the last element of the shard. */
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			shard& s = _local();
+			if(_ordered && s.tags.capacity_after() == 0)
+				s.tags.reserve_after(s.tags.size() + 1); // Tagging must not fail once the element is added
+			s.elements.emplace_back(std::forward<Args>(args)...);
+			if(_ordered)
+				s.tags.push_back(_sequence.fetch_add(1, std::memory_order_relaxed));
+		}
+
+		/** Adds a copy of val before the first element of the shard. */
+		void push_front(const value_type& val) {emplace_front(val);}
+
+		/** Adds val before the first element of the shard, moving it. */
+		void push_front(value_type&& val) {emplace_front(std::move(val));}
+
+		/** Constructs an element in place before the first element of the shard.
+		 * When order is preserved, the element is still collected in the order of pushes.
+		 */
+		template <class... Args>
+		void emplace_front(Args&&... args)
+		{
+			shard& s = _local();
+			if(_ordered && s.tags.capacity_before() == 0)
+				s.tags.reserve_before(s.tags.size() + 1);
+			s.elements.emplace_front(std::forward<Args>(args)...);
+			if(_ordered)
+				s.tags.push_front(_sequence.fetch_add(1, std::memory_order_relaxed));
+		}
+
+		/** @} */
+
+		/** Moves the elements of all shards into a single tape, allocated once, leaving shards empty with their storage.
+		 * Shards are concatenated, or elements are sorted by sequence tags when order is preserved.
+		 * Must not be called concurrently with pushes.
+		 * If a move throws, elements already moved in the collected tape are destroyed and the exception is rethrown once all threads are done,
+		 * shards are then left with moved-from elements.
+		 * \param threads Number of threads moving elements, 0 for one per hardware thread. Fewer threads are used for small tapes.
+		 */
+		tape_type collect(unsigned threads = 0)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			std::vector<size_type> offsets(_shards.size() + 1, 0);
+			for(size_type i = 0; i < _shards.size(); ++i)
+				offsets[i + 1] = offsets[i] + _shards[i]->elements.size();
+			const size_type n = offsets.back();
+
+			if(threads == 0)
+				threads = std::thread::hardware_concurrency();
+			size_type count = std::max<size_type>(1, std::min<size_type>(threads, n / parallel::min_chunk));
+
+			tape_type out(_alloc);
+			_collect(out, offsets, count);
+
+			for(size_type i = 0; i < _shards.size(); ++i)
+			{
+				_shards[i]->elements.clear();
+				_shards[i]->tags.clear();
+			}
+			_sequence.store(0, std::memory_order_relaxed);
+			return out;
+		}
+
+	protected:
+		/** Elements are move constructed in the uninitialized storage of the output, then adopted.
+		 * If a move throws, the elements constructed by every part are destroyed.
+		 */
+		void _collect(tape_type& out, const std::vector<size_type>& offsets, size_type count)
+		{
+			typedef std::allocator_traits<allocator_type> traits;
+			const size_type n = offsets.back();
+			allocator_type alloc = out.get_allocator();
+			value_type* dst = out.grow_back_uninitialized(n);
+			std::vector<size_type> done(count, 0); // Elements constructed by each part
+			try
+			{
+				parallel::run(count, [&](std::size_t part){
+					_visit(offsets, count, part, n, [&](size_type pos, value_type& val){
+						traits::construct(alloc, dst + pos, std::move(val));
+						++done[part];
+					});
+				});
+			}
+			catch(...)
+			{
+				for(size_type part = 0; part < count; ++part)
+					_visit(offsets, count, part, done[part], [&](size_type pos, value_type&){traits::destroy(alloc, dst + pos);});
+				throw;
+			}
+			out.commit_back(n);
+		}
+
+		/** Calls fn(position, element) for the limit first elements of the part of shards elements, out of count equal parts.
+		 * Position is the concatenation position, or the sequence tag when order is preserved.
+		 */
+		template <typename Fn>
+		void _visit(const std::vector<size_type>& offsets, size_type count, size_type part, size_type limit, Fn fn)
+		{
+			const size_type n = offsets.back();
+			size_type first = n * part / count, last = std::min(n * (part + 1) / count, first + limit);
+			for(size_type i = 0; i < _shards.size() && first < last; ++i)
+			{
+				if(offsets[i + 1] <= first)
+					continue;
+				shard& s = *_shards[i];
+				size_type end = std::min(last, offsets[i + 1]);
+				for(size_type k = first - offsets[i]; first < end; ++k, ++first)
+					fn(_ordered ? (size_type)s.tags[k] : first, s.elements[k]);
+			}
+		}
+
+		/** Returns the shard of the calling thread, creating it on first use. */
+		shard& _local()
+		{
+			static thread_local cache_entry cache = {0, nullptr};
+			if(cache.id == _id)
+				return *cache.s;
+			return _lookup(cache);
+		}
+
+		/** Finds or creates the shard of the calling thread in the registry, and caches it. */
+		CONTAINER_TAPE_NOINLINE shard& _lookup(cache_entry& cache)
+		{
+			std::thread::id self = std::this_thread::get_id();
+			std::lock_guard<std::mutex> lock(_mutex);
+			shard* s = nullptr;
+			for(size_type i = 0; i < _shards.size() && !s; ++i)
+				if(_shards[i]->owner == self)
+					s = _shards[i].get();
+			if(!s)
+			{
+				_shards.reserve(_shards.size() + 1);
+				_shards.push_back(std::unique_ptr<shard>(new shard(_alloc, self)));
+				s = _shards.back().get();
+			}
+			cache.id = _id;
+			cache.s = s;
+			return *s;
+		}
+
+		/** Returns a new identifier of sharded tape, starting at 1. */
+		static std::uint64_t _next_id()
+		{
+			static std::atomic<std::uint64_t> last(0);
+			return last.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+	};
+
+} // namespace container
+
+#endif // CPPCONTAINERS_SHARDED_TAPE_HPP
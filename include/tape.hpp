@@ -6,14 +6,53 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 // ----------------------------------------------------------------------------
 
+#ifndef CPPCONTAINERS_TAPE_HPP
+#define CPPCONTAINERS_TAPE_HPP
+
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <algorithm>
+#include <functional>
 #include <stdexcept>
+#include <type_traits>
 #include <initializer_list>
 #include <iterator>
 #include <utility>
 
+#include "tape_span.hpp"
+
+/** Keeps a function out of line, for slow paths which would prevent their callers to be inlined. */
+#if defined(__GNUC__) || defined(__clang__)
+#define CONTAINER_TAPE_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define CONTAINER_TAPE_NOINLINE __declspec(noinline)
+#else
+#define CONTAINER_TAPE_NOINLINE
+#endif
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define CONTAINER_TAPE_HAS_PMR 1
+#endif
+#endif
+
+#if __cplusplus > 201703L && defined(__cpp_lib_concepts)
+#define CONTAINER_TAPE_HAS_CONTIGUOUS_ITERATOR 1
+#endif
+
+/** Tapes are usable in constant expressions when the compiler supports allocation in them (C++20),
+ * so that tables can be built with tapes at compile time then copied to static arrays.
+ */
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define CONTAINER_TAPE_HAS_CONSTEXPR 1
+#define CONTAINER_TAPE_CONSTEXPR constexpr
+#else
+#define CONTAINER_TAPE_CONSTEXPR
+#endif
 
 
 namespace container
@@ -21,103 +60,282 @@ namespace container
 
 	/**
 	 * Tape iterator.
+	 * Elements of a tape are contiguous: under C++20 the iterator models std::contiguous_iterator,
+	 * so std::to_address() and algorithms recognizing contiguous ranges work on it as on pointers.
 	 */
 	template <class T>
-	class tape_iterator : public std::iterator<std::random_access_iterator_tag, T>
+	class tape_iterator
 	{
 	public:
 		typedef tape_iterator   self;
-		typedef std::iterator<std::random_access_iterator_tag, T>   parent;
-			
-		typedef typename parent::value_type			value_type;
-		typedef typename parent::difference_type		difference_type;
-		typedef typename parent::pointer				pointer;
-		typedef typename parent::reference			reference;
-		typedef typename parent::iterator_category   iterator_category;
+
+		typedef T								value_type;
+		typedef T								element_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef T*								pointer;
+		typedef T&								reference;
+		typedef std::random_access_iterator_tag	iterator_category;
+#ifdef CONTAINER_TAPE_HAS_CONTIGUOUS_ITERATOR
+		typedef std::contiguous_iterator_tag	iterator_concept;
+#endif
 
 	protected:
 		pointer _ptr;
 			
 	public:			
-		tape_iterator():_ptr(nullptr){}
-		explicit tape_iterator(pointer ptr):_ptr(ptr){}
-
-		pointer get_ptr()const {return _ptr;}
-
-		reference  operator*() const {return *_ptr;}
-		value_type operator->() const {return _ptr;}
-		reference operator[](difference_type off) const {return _ptr[off];}
-
-		self& operator++() {++_ptr; return *this;}
-		self  operator++(int) {pointer tmp = _ptr; ++*this; return self(tmp);}
-		self& operator--() {--_ptr; return *this;}
-		self  operator--(int) {pointer tmp = _ptr; --*this; return self(tmp);}
-
-		self& operator+=(difference_type off) {_ptr += off; return *this;}
-		self  operator+(difference_type off)const {return self(_ptr+off);}
-		friend self operator+(difference_type off, const self& right) {return self(off+right._ptr);}
-		self& operator-=(difference_type off) {_ptr -= off; return *this;}
-		self  operator-(difference_type off)const {return self(_ptr-off);}
-		difference_type operator-(const self& right)const {return _ptr - right._ptr;}
-
-		bool operator==(const self& r)const{return _ptr==r._ptr;}
-		bool operator!=(const self& r)const{return _ptr!=r._ptr;}
-		bool operator<(const self& r)const{return _ptr<r._ptr;}			
-		bool operator<=(const self& r)const{return _ptr<=r._ptr;}
-		bool operator>(const self& r)const{return _ptr>r._ptr;}			
-		bool operator>=(const self& r)const{return _ptr>=r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR tape_iterator():_ptr(nullptr){}
+		CONTAINER_TAPE_CONSTEXPR explicit tape_iterator(pointer ptr):_ptr(ptr){}
+
+		CONTAINER_TAPE_CONSTEXPR pointer get_ptr()const {return _ptr;}
+
+		CONTAINER_TAPE_CONSTEXPR reference operator*() const {return *_ptr;}
+		CONTAINER_TAPE_CONSTEXPR pointer   operator->() const {return _ptr;}
+		CONTAINER_TAPE_CONSTEXPR reference operator[](difference_type off) const {return _ptr[off];}
+
+		CONTAINER_TAPE_CONSTEXPR self& operator++() {++_ptr; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator++(int) {pointer tmp = _ptr; ++*this; return self(tmp);}
+		CONTAINER_TAPE_CONSTEXPR self& operator--() {--_ptr; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator--(int) {pointer tmp = _ptr; --*this; return self(tmp);}
+
+		CONTAINER_TAPE_CONSTEXPR self& operator+=(difference_type off) {_ptr += off; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator+(difference_type off)const {return self(_ptr+off);}
+		friend CONTAINER_TAPE_CONSTEXPR self operator+(difference_type off, const self& right) {return self(off+right._ptr);}
+		CONTAINER_TAPE_CONSTEXPR self& operator-=(difference_type off) {_ptr -= off; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator-(difference_type off)const {return self(_ptr-off);}
+		CONTAINER_TAPE_CONSTEXPR difference_type operator-(const self& right)const {return _ptr - right._ptr;}
+
+		CONTAINER_TAPE_CONSTEXPR bool operator==(const self& r)const{return _ptr==r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR bool operator!=(const self& r)const{return _ptr!=r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR bool operator<(const self& r)const{return _ptr<r._ptr;}			
+		CONTAINER_TAPE_CONSTEXPR bool operator<=(const self& r)const{return _ptr<=r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR bool operator>(const self& r)const{return _ptr>r._ptr;}			
+		CONTAINER_TAPE_CONSTEXPR bool operator>=(const self& r)const{return _ptr>=r._ptr;}
 	};
 
 	/**
 	 * Tape constant iterator.
+	 * Like tape_iterator, but giving read-only access to elements.
 	 */
 	template <class T>
-	class tape_const_iterator : public std::iterator<std::random_access_iterator_tag, T>
+	class tape_const_iterator
 	{
 	public:
 		typedef tape_const_iterator   self;
-		typedef std::iterator<std::random_access_iterator_tag, T>   parent;
-			
-		typedef typename parent::value_type			value_type;
-		typedef typename parent::difference_type	difference_type;
-		typedef typename parent::pointer			pointer;
-		typedef typename parent::reference			reference;
-		typedef typename parent::iterator_category  iterator_category;
+
+		typedef T								value_type;
+		typedef const T							element_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef const T*						pointer;
+		typedef const T&						reference;
+		typedef std::random_access_iterator_tag	iterator_category;
+#ifdef CONTAINER_TAPE_HAS_CONTIGUOUS_ITERATOR
+		typedef std::contiguous_iterator_tag	iterator_concept;
+#endif
 
 	protected:
 		pointer _ptr;
 
 	public:
-		tape_const_iterator():_ptr(nullptr){}
-		explicit tape_const_iterator(pointer ptr):_ptr(ptr){}
-		tape_const_iterator(const tape_iterator<T>& it):_ptr(it.get_ptr()){}
-
-		pointer get_ptr()const {return _ptr;}
-
-		const reference  operator*() const {return *_ptr;}
-		const value_type operator->() const {return _ptr;}
-		const reference operator[](difference_type off) const {return _ptr[off];}
-
-		self& operator++() {++_ptr; return *this;}
-		self  operator++(int) {pointer tmp = _ptr; ++*this; return self(tmp);}
-		self& operator--() {--_ptr; return *this;}
-		self  operator--(int) {pointer tmp = _ptr; --*this; return self(tmp);}
-
-		self& operator+=(difference_type off) {_ptr += off; return *this;}
-		self  operator+(difference_type off)const {return self(_ptr+off);}
-		friend self operator+(difference_type off, const self& right) {return self(off+right._ptr);}
-		self& operator-=(difference_type off) {_ptr -= off; return *this;}
-		self  operator-(difference_type off)const {return self(_ptr-off);}
-		difference_type operator-(const self& right)const {return _ptr - right._ptr;}
-
-		bool operator==(const self& r)const{return _ptr==r._ptr;}
-		bool operator!=(const self& r)const{return _ptr!=r._ptr;}
-		bool operator<(const self& r)const{return _ptr<r._ptr;}			
-		bool operator<=(const self& r)const{return _ptr<=r._ptr;}
-		bool operator>(const self& r)const{return _ptr>r._ptr;}			
-		bool operator>=(const self& r)const{return _ptr>=r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR tape_const_iterator():_ptr(nullptr){}
+		CONTAINER_TAPE_CONSTEXPR explicit tape_const_iterator(pointer ptr):_ptr(ptr){}
+		CONTAINER_TAPE_CONSTEXPR tape_const_iterator(const tape_iterator<T>& it):_ptr(it.get_ptr()){}
+
+		CONTAINER_TAPE_CONSTEXPR pointer get_ptr()const {return _ptr;}
+
+		CONTAINER_TAPE_CONSTEXPR reference operator*() const {return *_ptr;}
+		CONTAINER_TAPE_CONSTEXPR pointer   operator->() const {return _ptr;}
+		CONTAINER_TAPE_CONSTEXPR reference operator[](difference_type off) const {return _ptr[off];}
+
+		CONTAINER_TAPE_CONSTEXPR self& operator++() {++_ptr; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator++(int) {pointer tmp = _ptr; ++*this; return self(tmp);}
+		CONTAINER_TAPE_CONSTEXPR self& operator--() {--_ptr; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator--(int) {pointer tmp = _ptr; --*this; return self(tmp);}
+
+		CONTAINER_TAPE_CONSTEXPR self& operator+=(difference_type off) {_ptr += off; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator+(difference_type off)const {return self(_ptr+off);}
+		friend CONTAINER_TAPE_CONSTEXPR self operator+(difference_type off, const self& right) {return self(off+right._ptr);}
+		CONTAINER_TAPE_CONSTEXPR self& operator-=(difference_type off) {_ptr -= off; return *this;}
+		CONTAINER_TAPE_CONSTEXPR self  operator-(difference_type off)const {return self(_ptr-off);}
+		CONTAINER_TAPE_CONSTEXPR difference_type operator-(const self& right)const {return _ptr - right._ptr;}
+
+		CONTAINER_TAPE_CONSTEXPR bool operator==(const self& r)const{return _ptr==r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR bool operator!=(const self& r)const{return _ptr!=r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR bool operator<(const self& r)const{return _ptr<r._ptr;}			
+		CONTAINER_TAPE_CONSTEXPR bool operator<=(const self& r)const{return _ptr<=r._ptr;}
+		CONTAINER_TAPE_CONSTEXPR bool operator>(const self& r)const{return _ptr>r._ptr;}			
+		CONTAINER_TAPE_CONSTEXPR bool operator>=(const self& r)const{return _ptr>=r._ptr;}
 	};
 	
+	/** Tells if a type is an iterator, to keep range overloads away from calls with a count and a value of integral type. */
+	template <class Iterator, class Enable = void>
+	struct tape_is_iterator : std::false_type {};
+
+	template <class Iterator>
+	struct tape_is_iterator<Iterator, decltype(void(std::declval<typename std::iterator_traits<Iterator>::iterator_category>()))> : std::true_type {};
+
+	/** Tells if an allocator has a construct member for elements of type T. */
+	template <class Allocator, class T, class Enable = void>
+	struct tape_has_construct : std::false_type {};
+
+	template <class Allocator, class T>
+	struct tape_has_construct<Allocator, T, decltype(void(std::declval<Allocator&>().construct(std::declval<T*>(), std::declval<const T&>())))> : std::true_type {};
+
+	/** Tells if an allocator has a destroy member for elements of type T. */
+	template <class Allocator, class T, class Enable = void>
+	struct tape_has_destroy : std::false_type {};
+
+	template <class Allocator, class T>
+	struct tape_has_destroy<Allocator, T, decltype(void(std::declval<Allocator&>().destroy(std::declval<T*>())))> : std::true_type {};
+
+	/**
+	 * Tells if an allocator customizes the construction of elements of type T.
+	 * std::allocator construct member does the same as placement new, so it does not count.
+	 */
+	template <class Allocator, class T>
+	struct tape_custom_construct
+	: std::integral_constant<bool, tape_has_construct<Allocator, T>::value && !std::is_same<Allocator, std::allocator<T> >::value> {};
+
+	/**
+	 * Tells if an allocator customizes the destruction of elements of type T.
+	 * std::allocator destroy member does the same as calling the destructor, so it does not count.
+	 */
+	template <class Allocator, class T>
+	struct tape_custom_destroy
+	: std::integral_constant<bool, tape_has_destroy<Allocator, T>::value && !std::is_same<Allocator, std::allocator<T> >::value> {};
+
+#ifdef CONTAINER_TAPE_HAS_PMR
+	/** Polymorphic allocator destroy member only calls the destructor. */
+	template <class T>
+	struct tape_custom_destroy<std::pmr::polymorphic_allocator<T>, T> : std::false_type {};
+#endif
+
+	/**
+	 * Tape statistics policy which does not record anything.
+	 * This is the default policy of tapes, all its hooks are empty and are optimized away.
+	 */
+	struct tape_no_stats
+	{
+		CONTAINER_TAPE_CONSTEXPR void on_allocate(std::size_t /*capacity*/, std::size_t /*bytes*/) {}
+		CONTAINER_TAPE_CONSTEXPR void on_reallocate() {}
+		CONTAINER_TAPE_CONSTEXPR void on_move(std::size_t /*n*/) {}
+		CONTAINER_TAPE_CONSTEXPR void on_slack(std::size_t /*before*/, std::size_t /*after*/) {}
+	};
+
+	/**
+	 * Tape statistics policy recording memory operations.
+	 * Use it as third template parameter of a tape to know how much it allocates and copies,
+	 * for example to tune its reservations.
+	 * Statistics belong to a tape instance, they are neither copied, moved nor swapped with its content.
+	 */
+	struct tape_stats
+	{
+		std::size_t allocations;			//!< Number of memory allocations.
+		std::size_t allocated_bytes;		//!< Total of allocated memory, in bytes.
+		std::size_t reallocations;			//!< Number of reallocations of existing content.
+		std::size_t moved_elements;			//!< Number of elements relocated from a place to another (reallocation, insertion or erasure).
+		std::size_t peak_capacity;			//!< High-water mark of capacity, in elements.
+		std::size_t peak_capacity_before;	//!< High-water mark of free slots before the first element.
+		std::size_t peak_capacity_after;	//!< High-water mark of free slots after the last element.
+
+		CONTAINER_TAPE_CONSTEXPR tape_stats()
+		{
+			reset();
+		}
+
+		/** Reset all counters to zero. */
+		CONTAINER_TAPE_CONSTEXPR void reset()
+		{
+			allocations = allocated_bytes = reallocations = moved_elements = 0;
+			peak_capacity = peak_capacity_before = peak_capacity_after = 0;
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void on_allocate(std::size_t capacity, std::size_t bytes)
+		{
+			++allocations;
+			allocated_bytes += bytes;
+			if(capacity > peak_capacity)
+				peak_capacity = capacity;
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void on_reallocate()
+		{
+			++reallocations;
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void on_move(std::size_t n)
+		{
+			moved_elements += n;
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void on_slack(std::size_t before, std::size_t after)
+		{
+			if(before > peak_capacity_before)
+				peak_capacity_before = before;
+			if(after > peak_capacity_after)
+				peak_capacity_after = after;
+		}
+	};
+
+	/**
+	 * Tape shrink policy.
+	 * Tells when a tape automatically releases memory as elements are removed.
+	 *
+	 * A tape shrinks when its size falls below shrink_below times its capacity.
+	 * It is then reallocated with a capacity of shrink_to times its size, slack being split on both sides.
+	 * Keeping shrink_to * shrink_below well below 1 gives an hysteresis preventing a tape oscillating around
+	 * a threshold to reallocate again and again.
+	 *
+	 * When deferred, removals never shrink the tape by themselves, the policy is only applied
+	 * when calling tape::maybe_shrink(), keeping reallocations off the hot path.
+	 *
+	 * A tape used as a queue (push_back and pop_front) or a sliding window accumulates free slots on the side it is consumed from.
+	 * When slide_above is set and room is missing on one side while free slots on the other side exceed slide_above times the capacity,
+	 * elements are slid over these free slots instead of reallocating.
+	 * Reservations on one side then slide or reallocate like growth does, instead of keeping the free slots of the other side.
+	 * An emptied tape also restarts from the place given by its learned growth bias.
+	 * So memory stays proportional to the window of live elements, and a steady queue stops allocating.
+	 * Each slide moves at most the capacity to reclaim at least slide_above times the capacity, so its cost is amortized.
+	 *
+	 * Use tape_shrink_policy as fourth template parameter of a tape to set its policy at runtime.
+	 * A default constructed policy never shrinks nor slides.
+	 */
+	struct tape_shrink_policy
+	{
+		float		shrink_below;	//!< Fraction of capacity under which the size triggers a shrink. 0 disables shrinking.
+		float		shrink_to;		//!< New capacity after a shrink, as a factor of the size. Must be at least 1.
+		std::size_t	min_capacity;	//!< Capacity under which a tape is never shrunk.
+		bool		deferred;		//!< Only shrink on explicit tape::maybe_shrink() calls.
+		float		slide_above;	//!< Fraction of capacity above which free slots on one side are reused by sliding elements when room is missing on the other. 0 disables sliding.
+
+		CONTAINER_TAPE_CONSTEXPR tape_shrink_policy(float shrink_below = 0.0f, float shrink_to = 2.0f, std::size_t min_capacity = 0, bool deferred = false, float slide_above = 0.0f):
+		shrink_below(shrink_below), shrink_to(shrink_to < 1.0f ? 1.0f : shrink_to), min_capacity(min_capacity), deferred(deferred), slide_above(slide_above)
+		{}
+
+		/** Returns a policy for queues and sliding windows, reclaiming free slots left by removals without shrinking. */
+		static CONTAINER_TAPE_CONSTEXPR tape_shrink_policy sliding_window(float slide_above = 0.5f)
+		{
+			return tape_shrink_policy(0.0f, 2.0f, 0, false, slide_above);
+		}
+
+		/** Returns true if the policy may shrink a tape. */
+		CONTAINER_TAPE_CONSTEXPR bool enabled() const {return shrink_below > 0.0f;}
+
+		/** Returns true if the policy reuses free slots by sliding elements. */
+		CONTAINER_TAPE_CONSTEXPR bool slides() const {return slide_above > 0.0f;}
+
+		/** Returns the settings of the policy, as a shrink policy parameter of tapes. */
+		CONTAINER_TAPE_CONSTEXPR const tape_shrink_policy& get() const {return *this;}
+	};
+
+	/**
+	 * Tape shrink policy which never shrinks nor slides.
+	 * This is the default policy of tapes: it is empty and its settings are constants, so the code applying them is optimized away.
+	 */
+	struct tape_no_shrink
+	{
+		CONTAINER_TAPE_CONSTEXPR tape_shrink_policy get() const {return tape_shrink_policy();}
+	};
+
 	/**
 	 * Tapes are sequence containers representing arrays that can change in size (like STL vectors).
 	 *
@@ -156,11 +374,16 @@ namespace container
 	 * \tparam T Type of the elements. Only if T is guaranteed to not throw while moving, implementations can optimize to move elements instead of copying them during reallocations. Aliased as member type tape::value_type.
 	 *
      * \tparam Allocator Type of the allocator object used to define the storage allocation model. By default, the allocator class template is used, which defines the simplest memory allocation model and is value-independent. Aliased as member type tape::allocator_type.
+	 *
+	 * \tparam Stats Statistics policy notified of memory operations. By default, tape_no_stats records nothing and costs nothing. Use tape_stats to count allocations, reallocations and element moves. Aliased as member type tape::stats_type.
+	 *
+	 * \tparam Shrink Shrink policy, telling when removals release memory or slide elements. By default, tape_no_shrink never does and costs nothing. Use tape_shrink_policy to set the policy at runtime. Aliased as member type tape::shrink_type.
 	 */
-	template <typename T, typename Allocator = std::allocator<T> >
-	class tape
+	template <typename T, typename Allocator = std::allocator<T>, typename Stats = tape_no_stats, typename Shrink = tape_no_shrink >
+	class tape : private Stats, private Shrink
 	{
 		typedef Allocator base_t;
+		typedef std::allocator_traits<Allocator> alloc_traits;
 	public:
 		/**
 		 * 
@@ -170,10 +393,10 @@ namespace container
 		typedef T											value_type;			//!< The type of object stored in the vector. The first template parameter (T).
 		typedef Allocator									allocator_type;		//!< The type of allocator used for internal memory management. The second template parameter (Allocator). Defaults to std::allocator<value_type>.
 
-		typedef typename allocator_type::reference			reference;			//!< Reference to the stored element.
-		typedef typename allocator_type::const_reference	const_reference;	//!< Const reference to the stored element.
-		typedef typename allocator_type::pointer			pointer;			//!< Pointer to the stored element.
-		typedef typename allocator_type::const_pointer		const_pointer;		//!< Const pointer to the stored element.
+		typedef value_type&									reference;			//!< Reference to the stored element.
+		typedef const value_type&							const_reference;	//!< Const reference to the stored element.
+		typedef typename std::allocator_traits<allocator_type>::pointer			pointer;		//!< Pointer to the stored element.
+		typedef typename std::allocator_traits<allocator_type>::const_pointer	const_pointer;	//!< Const pointer to the stored element.
 
 		typedef tape_iterator<value_type>					iterator;			//!< Random access iterator to value_type.
 		typedef tape_const_iterator<value_type>				const_iterator;		//!< Random access iterator to const value_type.
@@ -182,15 +405,37 @@ namespace container
 			
 		typedef ptrdiff_t									difference_type;	//!< Signed integral type representing the distance between two stored objects. Identical to iterator_traits<iterator>::difference_type. Usually the same as ptrdiff_t.
 		typedef size_t										size_type;			//!< Unsigned integral type that can represent any non-negative value of difference_type like a quantity of elments. Usually same as size_t.
+
+		typedef Stats										stats_type;			//!< The statistics policy. The third template parameter (Stats). Defaults to tape_no_stats.
+		typedef Shrink										shrink_type;		//!< The shrink policy. The fourth template parameter (Shrink). Defaults to tape_no_shrink.
 		/** \} */
 			
 	protected:
 		allocator_type _alloc;  // Allocator
+		std::uint32_t _bias;	// Learned growth bias, packed (see _bias_share)
 		pointer		_base;		// Base allocated memory chunck
 		pointer		_start;		// Begining of used memory (first element)
 		size_type   _size;		// Number of used elements
 		size_type	_capacity;  // Size of allocated memory in nb of elements
 
+		/** Packing of the growth bias, kept in 32 bits next to the allocator, which is usually empty.
+		 * Low bits are the learned share of growth happening before first element, in 256ths.
+		 * Then come the free slots before and after elements at last reallocation or recentering, in 4095ths of the capacity. */
+		static const unsigned _bias_share_bits = 8;			// Bits of the front share.
+		static const std::uint32_t _bias_share = 0xFF;		// Mask of the front share.
+		static const std::uint32_t _bias_half = 0x80;		// Front share of a tape which has not grown yet.
+		static const unsigned _bias_slack_bits = 12;		// Bits of each free slots count.
+		static const std::uint32_t _bias_slack_one = 0xFFF;	// Free slots count of the whole capacity.
+
+		/** Elements need no destruction: trivially destructible, and not destroyed by a custom allocator destroy. */
+		typedef std::integral_constant<bool, std::is_trivially_destructible<T>::value
+			&& !tape_custom_destroy<Allocator, T>::value>				_trivial_destroy;
+		/** Elements can be copied and relocated bytewise (memcpy, memmove, memset): trivially copyable,
+		 * neither constructed nor destroyed by custom allocator members, and stored at raw pointers. */
+		typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value
+			&& !tape_custom_construct<Allocator, T>::value && !tape_custom_destroy<Allocator, T>::value
+			&& std::is_same<pointer, value_type*>::value>					_bitwise;
+
 	public:
 		/**
 		 * \name Construct / Copy / Destroy
@@ -201,13 +446,13 @@ namespace container
 		 * \param alloc Eventual allocator sample.
 		 */
 #if   __cplusplus < 201402L // (until C++14)
-		explicit tape(const allocator_type& alloc = allocator_type())
+		CONTAINER_TAPE_CONSTEXPR explicit tape(const allocator_type& alloc = allocator_type())
 #elif __cplusplus >= 201402L && __cplusplus < 201703L // (since C++14)(until C++17)
-		explicit tape(const allocator_type& alloc)
+		CONTAINER_TAPE_CONSTEXPR explicit tape(const allocator_type& alloc)
 #else // (since C++17)
-		explicit tape( const Allocator& alloc ) noexcept
+		CONTAINER_TAPE_CONSTEXPR explicit tape( const Allocator& alloc ) noexcept
 #endif
-		:_alloc(alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		:_alloc(alloc), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{}
 
 		/** Default constructor.
@@ -215,9 +460,9 @@ namespace container
 		 * \param alloc Eventual allocator sample.
 		 */
 #if   __cplusplus >= 201402L && __cplusplus < 201703L // (since C++14)(until C++17)
-		tape() : tape( Allocator() ) {}
+		CONTAINER_TAPE_CONSTEXPR tape() : tape( Allocator() ) {}
 #elif __cplusplus >= 201703L // (since C++17)
-		tape() noexcept(noexcept(Allocator())): tape( Allocator() ) {}
+		CONTAINER_TAPE_CONSTEXPR tape() noexcept(noexcept(Allocator())): tape( Allocator() ) {}
 #endif
 
 		/** Filling constructor.
@@ -226,8 +471,8 @@ namespace container
 		 * \param val Value to fill the container with. Each of the n elements in the container will be initialized to a copy of this value.
 		 * \param alloc Eventual allocator sample.
 		 */
-		tape(size_type n, const value_type& val, const allocator_type& alloc = allocator_type())
-		:_alloc(alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		CONTAINER_TAPE_CONSTEXPR tape(size_type n, const value_type& val, const allocator_type& alloc = allocator_type())
+		:_alloc(alloc), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->resize(n, val);
 		}
@@ -237,14 +482,14 @@ namespace container
 		 * \param n Number of element to store in container.
 		 */
 #if   /*__cplusplus >= 201103L &&*/ __cplusplus < 201402L // (since C++11)(until C++14)
-		explicit tape(size_type n):
-		_alloc(), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		CONTAINER_TAPE_CONSTEXPR explicit tape(size_type n):
+		_alloc(), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->resize(n);
 		}
 #elif __cplusplus >= 201402L // (since C++14)
-		explicit tape(size_type n, const allocator_type& alloc = allocator_type()):
-		_alloc(alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		CONTAINER_TAPE_CONSTEXPR explicit tape(size_type n, const allocator_type& alloc = allocator_type()):
+		_alloc(alloc), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->resize(n);
 		}
@@ -258,19 +503,20 @@ namespace container
 		 * \param last Input iterators to the final positions in a range.
 		 * \param alloc Eventual allocator sample.
 		 */
-		template <class InputIterator>
-		tape(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type()):
-		_alloc(alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		template <class InputIterator, class = typename std::enable_if<tape_is_iterator<InputIterator>::value>::type>
+		CONTAINER_TAPE_CONSTEXPR tape(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type()):
+		_alloc(alloc), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->assign(first, last);
 		}
 
 		/** Copy constructor.
 		 * Constructs a container with a copy of each of the elements in x, in the same order.
+		 * Allocator is obtained by std::allocator_traits::select_on_container_copy_construction from the allocator of x.
 		 * \param x Another tape object of the same type (with the same class template arguments T and Alloc), whose contents are either copied or acquired.
 		 */
-		tape( const tape& x):
-		_alloc(x._alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		CONTAINER_TAPE_CONSTEXPR tape( const tape& x):
+		Shrink(x), _alloc(alloc_traits::select_on_container_copy_construction(x._alloc)), _bias(x._bias & _bias_share), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->assign(x.begin(), x.end());
 		}
@@ -280,8 +526,8 @@ namespace container
 		 * \param x Another tape object of the same type (with the same class template arguments T and Alloc), whose contents are either copied or acquired.
 		 * \param alloc Eventual allocator sample.
 		 */
-		tape( const tape& x, const allocator_type& alloc):
-		_alloc(alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		CONTAINER_TAPE_CONSTEXPR tape( const tape& x, const allocator_type& alloc):
+		Shrink(x), _alloc(alloc), _bias(x._bias & _bias_share), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->assign(x.begin(), x.end());
 		}
@@ -292,27 +538,32 @@ namespace container
 		 * After the move, other is guaranteed to be empty().
 		 * \param other Another tape object to be used as source to initialize the elements of the container with.
 		 */
-		tape(tape&& other)
+		CONTAINER_TAPE_CONSTEXPR tape(tape&& other)
 #if   __cplusplus >= 201703L // (since C++17)
 			noexcept
 #endif
-		:_alloc(std::move(other._alloc)),
-		_base(other._base), _start(other._start), _size(other._size), _capacity(other._capacity)
+		:Shrink(other), _alloc(std::move(other._alloc)), _bias(other._bias & _bias_share), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
-			other._base = other._start = nullptr;
-			other._size = other._capacity = 0;
+			_steal(other);
 		}
 
 		/** Allocator-extended move constructor.
+		 * If alloc compares equal to the allocator of other, the storage of other is taken over,
+		 * otherwise elements are moved one by one in memory allocated with alloc.
+		 * After the move, other is guaranteed to be empty().
 		 * \param other Another tape object to be used as source to initialize the elements of the container with.
 		 * \param alloc Allocator sample.
 		 */
-		tape(tape&& other, const allocator_type& alloc):
-		_alloc(alloc),
-		_base(other._base), _start(other._start), _size(other._size), _capacity(other._capacity)
+		CONTAINER_TAPE_CONSTEXPR tape(tape&& other, const allocator_type& alloc):
+		Shrink(other), _alloc(alloc), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
-			other._base = other._start = nullptr;
-			other._size = other._capacity = 0;
+			if(_alloc == other._alloc)
+				_steal(other);
+			else if(!other.empty())
+			{
+				this->assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+				other.clear();
+			}
 		}
 
 
@@ -321,13 +572,13 @@ namespace container
 		 * \param init Initializer list to initialize the elements of the container with.
 		 * \param alloc Eventual allocator sample.
 		 */
-		tape(std::initializer_list<value_type> init, const Allocator& alloc = Allocator()):
-		_alloc(alloc), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
+		CONTAINER_TAPE_CONSTEXPR tape(std::initializer_list<value_type> init, const Allocator& alloc = Allocator()):
+		_alloc(alloc), _bias(_bias_half), _base(nullptr), _start(nullptr), _size(0), _capacity(0)
 		{
 			this->assign(init.begin(), init.end());
 		}
 
-		~tape()
+		CONTAINER_TAPE_CONSTEXPR ~tape()
 		{
 			this->_destroy_all();
 			this->_deallocate();
@@ -335,34 +586,59 @@ namespace container
 
 		/** Copy assignment.
 		 * Assigns new contents to the container, replacing its current contents, and modifying its size accordingly.
-		 * The container preserves its current allocator, which is used to allocate storage in case of reallocation.
+		 * The container preserves its current allocator, which is used to allocate storage in case of reallocation,
+		 * unless the allocator propagates on copy assignment (see std::allocator_traits::propagate_on_container_copy_assignment).
 		 * Any elements held in the container before the call are either assigned to or destroyed.
 		 * \param x A tape object of the same type (i.e., with the same template parameters, T and Alloc).
 		 */
-		tape& operator=(const tape& x)
+		CONTAINER_TAPE_CONSTEXPR tape& operator=(const tape& x)
 		{
 			if(&x != this)
+			{
+				if(alloc_traits::propagate_on_container_copy_assignment::value)
+				{
+					if(_alloc != x._alloc)
+					{
+						// Memory must be released by the allocator which allocated it.
+						_destroy_all();
+						_deallocate();
+					}
+					_assign_alloc(x._alloc, typename alloc_traits::propagate_on_container_copy_assignment());
+				}
 				this->assign(x.begin(), x.end());
+			}
 			return *this;
 		}
 
 		/**
 		 * Move assignment operator.
 		 * Replaces the contents with those of other using move semantics.
+		 * Previous elements are destroyed and previous storage is released.
+		 * If the allocator propagates on move assignment or if allocators compare equal, the storage of other is taken over,
+		 * otherwise elements are moved one by one in storage allocated with the current allocator.
+		 * After the move, other is guaranteed to be empty().
 		 * \param other Another tape to use as data source 
 		 */
-		tape& operator=(tape&& other)
+		CONTAINER_TAPE_CONSTEXPR tape& operator=(tape&& other)
 #if   __cplusplus >= 201703L // (since C++17)
-		noexcept // TODO Review this
+		noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
 #endif
 		{
-			_alloc = std::move(other._alloc);
-			_base = other._base;
-			_start = other._start;
-			_size = other._size;
-			_capacity = other._capacity;
-			other._base = other._start = nullptr;
-			other._size = other._capacity = 0;
+			if(&other != this)
+			{
+				if(alloc_traits::propagate_on_container_move_assignment::value || _alloc == other._alloc)
+				{
+					_destroy_all();
+					_deallocate();
+					_move_alloc(other._alloc, typename alloc_traits::propagate_on_container_move_assignment());
+					_steal(other);
+				}
+				else
+				{
+					this->assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+					other.clear();
+				}
+			}
 			return *this;
 		}
 
@@ -370,7 +646,7 @@ namespace container
 		 * Replaces the contents with those identified by initializer list ilist.
 		 * \param ilist Initializer list to use as data source.
 		 */
-		tape& operator=( std::initializer_list<value_type> ilist )
+		CONTAINER_TAPE_CONSTEXPR tape& operator=( std::initializer_list<value_type> ilist )
 		{
 			this->assign(ilist.begin(), ilist.end());
 			return *this;
@@ -389,7 +665,7 @@ namespace container
 		 * If the container is empty, the returned iterator value shall not be dereferenced.
 		 * \return A random access iterator to the beginning of the sequence container.
 		 */
-		iterator begin() noexcept
+		CONTAINER_TAPE_CONSTEXPR iterator begin() noexcept
 		{return iterator(_start);}
 
 		/** Returns a const iterator pointing to the first element in the vector.
@@ -398,7 +674,7 @@ namespace container
 		 * If the container is empty, the returned iterator value shall not be dereferenced.
 		 * \return A constant random access iterator to the beginning of the sequence container.
 		 */
-		const_iterator begin() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_iterator begin() const noexcept
 		{return const_iterator(_start);}
 
 		/** Returns a const iterator pointing to the first element in the vector.
@@ -407,7 +683,7 @@ namespace container
 		 * If the container is empty, the returned iterator value shall not be dereferenced.
 		 * \return A constant random access iterator to the beginning of the sequence container.
 		 */
-		const_iterator cbegin() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_iterator cbegin() const noexcept
 		{return const_iterator(_start);}
 
 		/** Returns an iterator referring to the past-the-end element in the tape container.
@@ -418,7 +694,7 @@ namespace container
 		 * If the container is empty, this function returns the same as tape::begin.
 		 * \return A random access iterator to the element past the end of the sequence.
 		 */
-		iterator end() noexcept
+		CONTAINER_TAPE_CONSTEXPR iterator end() noexcept
 		{return iterator(_start+_size);}
 		
 		/** Returns a const iterator referring to the past-the-end element in the tape container.
@@ -429,7 +705,7 @@ namespace container
 		 * If the container is empty, this function returns the same as tape::begin.
 		 * \return A constant random access iterator to the element past the end of the sequence.
 		 */
-		const_iterator end() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_iterator end() const noexcept
 		{return const_iterator(_start+_size);}
 
 		/** Returns a const iterator referring to the past-the-end element in the tape container.
@@ -440,7 +716,7 @@ namespace container
 		 * If the container is empty, this function returns the same as tape::begin.
 		 * \return A constant random access iterator to the element past the end of the sequence.
 		 */
-		const_iterator cend() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_iterator cend() const noexcept
 		{return const_iterator(_start+_size);}
 
 		/** Returns a reverse iterator pointing to the last element in the tape (i.e., its reverse beginning).
@@ -449,7 +725,7 @@ namespace container
 		 * Notice that unlike member tape::back, which returns a reference to this same element, this function returns a reverse random access iterator.
 		 * \return A reverse iterator to the reverse beginning of the sequence container.
 		 */
-		reverse_iterator rbegin() noexcept
+		CONTAINER_TAPE_CONSTEXPR reverse_iterator rbegin() noexcept
 		{return reverse_iterator(end());}
 
 		/** Returns a const reverse iterator pointing to the last element in the tape (i.e., its reverse beginning).
@@ -458,7 +734,7 @@ namespace container
 		 * Notice that unlike member tape::back, which returns a reference to this same element, this function returns a reverse random access iterator.
 		 * \return A constant reverse iterator to the reverse beginning of the sequence container.
 		 */
-		const_reverse_iterator rbegin() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_reverse_iterator rbegin() const noexcept
 		{return const_reverse_iterator(end());}
 
 		/** Returns a const reverse iterator pointing to the last element in the tape (i.e., its reverse beginning).
@@ -467,28 +743,28 @@ namespace container
 		 * Notice that unlike member tape::back, which returns a reference to this same element, this function returns a reverse random access iterator.
 		 * \return A constant reverse iterator to the reverse beginning of the sequence container.
 		 */
-		const_reverse_iterator crbegin() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_reverse_iterator crbegin() const noexcept
 		{return const_reverse_iterator(end());}
 
 		/** Returns a reverse iterator pointing to the theoretical element preceding the first element in the tape (which is considered its reverse end).
 		 * The range between tape::rbegin and tape::rend contains all the elements of the tape (in reverse order).
 		 * \return A reverse iterator to the reverse end of the sequence container.
 		 */
-		reverse_iterator rend() noexcept
+		CONTAINER_TAPE_CONSTEXPR reverse_iterator rend() noexcept
 		{return reverse_iterator(begin());}
 
 		/** Returns a const reverse iterator pointing to the theoretical element preceding the first element in the tape (which is considered its reverse end).
 		 * The range between tape::rbegin and tape::rend contains all the elements of the tape (in reverse order).
 		 * \return A constant reverse iterator to the reverse end of the sequence container.
 		 */
-		const_reverse_iterator rend() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_reverse_iterator rend() const noexcept
 		{return const_reverse_iterator(begin());}
 
 		/** Returns a const reverse iterator pointing to the theoretical element preceding the first element in the tape (which is considered its reverse end).
 		 * The range between tape::crbegin and tape::crend contains all the elements of the tape (in reverse order).
 		 * \return A constant reverse iterator to the reverse end of the sequence container.
 		 */
-		const_reverse_iterator crend() const noexcept
+		CONTAINER_TAPE_CONSTEXPR const_reverse_iterator crend() const noexcept
 		{return const_reverse_iterator(begin());}
 		/** \} */
 
@@ -501,14 +777,14 @@ namespace container
 		 * To clear the content of a tape, see tape::clear.
 		 * \return true if the container size is 0, false otherwise.
 		 */
-		bool empty() const noexcept
+		CONTAINER_TAPE_CONSTEXPR bool empty() const noexcept
 		{return this->_size==0;}
 		
 		/** Returns the number of elements in the tape.
 		 * This is the number of actual objects held in the tape, which is not necessarily equal to its storage capacity.
 		 * \return The number of elements in the container.
 		 */
-		size_type size() const noexcept
+		CONTAINER_TAPE_CONSTEXPR size_type size() const noexcept
 		{return this->_size;}
 		
 		/** Returns the maximum number of elements that the tape can hold.
@@ -516,7 +792,7 @@ namespace container
 		 * but the container is by no means guaranteed to be able to reach that size: it can still fail to allocate storage at any point before that size is reached.
 		 * \return The maximum number of elements a tape container can hold as content.
 		 */
-		size_type max_size() const noexcept
+		CONTAINER_TAPE_CONSTEXPR size_type max_size() const noexcept
 		{return std::allocator_traits<allocator_type>::max_size(_alloc);}
 
 		/** Resizes the container so that it contains n elements.
@@ -526,7 +802,7 @@ namespace container
 		 * Notice that this function changes the actual content of the container by inserting or erasing elements from it.
 		 * \param new_size New container size, expressed in number of elements.
 		 */
-		void resize(size_type new_size)
+		CONTAINER_TAPE_CONSTEXPR void resize(size_type new_size)
 		{
 			if(new_size < size())
 			{
@@ -535,14 +811,12 @@ namespace container
 			}
 			else
 			{
-				// Reserve enought memory
-				reserve(new_size);
-				// Copy enought default elements at the end of exising.
-				while(size()<new_size)
-				{
-					*end() = value_type(); // TODO Optimize it !
-					_size++;
-				}
+				// Construct value-initialized elements at the end
+				size_type n = new_size - _size;
+				if(capacity_after() < n)
+					_grow(0, n);
+				_value_construct_n(_start + _size, n);
+				_size = new_size;
 			}
 		}
 
@@ -555,7 +829,7 @@ namespace container
 		 * \param new_size New container size, expressed in number of elements.
 		 * \param val Object whose content is copied to the added elements in case that n is greater than the current container size.
 		 */
-		void resize(size_type new_size, const value_type& val)
+		CONTAINER_TAPE_CONSTEXPR void resize(size_type new_size, const value_type& val)
 		{
 			if(new_size < size())
 			{
@@ -564,11 +838,8 @@ namespace container
 			}
 			else
 			{
-				// Reserve enought memory
-				reserve(new_size);
-				// Copy enought default elements at the end of exising.
-				while(size()<new_size)
-					push_back(val); // TODO Optimize it !
+				// Construct copies of val at the end
+				push_back(val, new_size - _size);
 			}
 		}
 
@@ -580,7 +851,7 @@ namespace container
 		 * The theoretical limit on the size of a tape is given by member max_size.
 		 * \return The size of the currently allocated storage capacity in the tape, measured in terms of the number elements it can hold.
 		 */
-		size_type capacity() const noexcept
+		CONTAINER_TAPE_CONSTEXPR size_type capacity() const noexcept
 		{
 			return _capacity;
 		}
@@ -590,7 +861,7 @@ namespace container
 		 * When this capacity is exhausted and more is needed, it is automatically expanded by the container (reallocating it storage space).
 		 * \return The size of the currently allocated storage capacity free to prepend elements in the tape, measured in terms of the number elements it can hold.
 		 */
-		size_type capacity_before() const noexcept
+		CONTAINER_TAPE_CONSTEXPR size_type capacity_before() const noexcept
 		{
 			return _start - _base;
 		}
@@ -600,62 +871,155 @@ namespace container
 		 * When this capacity is exhausted and more is needed, it is automatically expanded by the container (reallocating it storage space).
 		 * \return The size of the currently allocated storage capacity free to append elements in the tape, measured in terms of the number elements it can hold.
 		 */
-		size_type capacity_after() const noexcept
+		CONTAINER_TAPE_CONSTEXPR size_type capacity_after() const noexcept
 		{
 			return _capacity - ( capacity_before() + _size) ;
 		}
 
 		/** Request a change in capacity. */
-		void reserve(size_type n)
+		CONTAINER_TAPE_CONSTEXPR void reserve(size_type n)
 		{
 			reserve(capacity_before(), n);
 		}
 			
 		/** Request a change in capacity. */
-		void reserve(size_type before, size_type after)
+		CONTAINER_TAPE_CONSTEXPR void reserve(size_type before, size_type after)
 		{
 			if(capacity_before() < before || capacity_after() < after)
 				_reallocate(before, after);
 		}
 
 		/** Request to reserve a capacity before used space. */
-		void reserve_before(size_type before)
+		CONTAINER_TAPE_CONSTEXPR void reserve_before(size_type before)
 		{
 			if(capacity_before() < before)
-				_reallocate(before, capacity_after());
+			{
+				if(_shrink().slides())
+					_grow(before, 0); // Do not keep free slots of a sliding window
+				else
+					_reallocate(before, capacity_after());
+			}
 		}
 
 		/** Request to reserve a capacity after used space. */
-		void reserve_after(size_type after)
+		CONTAINER_TAPE_CONSTEXPR void reserve_after(size_type after)
 		{
 			if(capacity_after() < after)
-				_reallocate(capacity_before(), after);
+			{
+				if(_shrink().slides())
+					_grow(0, after); // Do not keep free slots of a sliding window
+				else
+					_reallocate(capacity_before(), after);
+			}
+		}
+
+		/** Moves elements inside the allocated storage, to leave exactly before free slots before the first element and the others after the last one.
+		 * No allocation is done, elements are shifted by moves. Does nothing if the tape has no allocated storage.
+		 * \throw std::out_of_range if before exceeds the free capacity (capacity() - size()).
+		 */
+		CONTAINER_TAPE_CONSTEXPR void recenter(size_type before)
+		{
+			if(before > _capacity - _size)
+				throw std::out_of_range("tape::recenter");
+			pointer start = _base + before;
+			if(start < _start)
+				_move_left(start, _start, _start + _size);
+			else if(start > _start)
+				_move_right(_start, _start + _size, start + _size);
+			_start = start;
+			_track_slack();
 		}
 
 		/** Requests the container to reduce its capacity to fit its size.
 		 * The request is non-binding, and the container implementation is free to optimize otherwise and leave the tape with a capacity greater than its size.
 		 * This may cause a reallocation, but has no effect on the tape size and cannot alter its elements. */
-		void shrink_to_fit()
+		CONTAINER_TAPE_CONSTEXPR void shrink_to_fit()
 		{
 			_reallocate(0, 0);
 		}
 
+		/** Returns the settings of the shrink policy of the tape. */
+		CONTAINER_TAPE_CONSTEXPR tape_shrink_policy get_shrink_policy() const noexcept
+		{
+			return _shrink();
+		}
+
+		/** Set the shrink policy of the tape, when its shrink policy parameter is tape_shrink_policy.
+		 * The policy is a property of the tape object: it is copied by copy and move construction,
+		 * but it is neither assigned nor swapped with the content.
+		 * The new policy is applied from the next removal, or the next maybe_shrink() call if deferred.
+		 * \param policy New shrink policy.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void set_shrink_policy(const tape_shrink_policy& policy) noexcept
+		{
+			static_cast<Shrink&>(*this) = policy;
+		}
+
+		/** Applies the shrink policy, even if it is deferred.
+		 * If the size has fallen below the policy threshold, the tape is reallocated to a smaller capacity.
+		 * Does nothing if the policy is disabled or if memory cannot be allocated.
+		 * \return true if the tape has been shrunk.
+		 */
+		CONTAINER_TAPE_CONSTEXPR bool maybe_shrink()
+		{
+			const tape_shrink_policy policy = _shrink();
+			if(!policy.enabled() || _capacity <= policy.min_capacity || _size >= _capacity * policy.shrink_below)
+				return false;
+
+			size_type capa = (size_type)(_size * policy.shrink_to);
+			if(capa < _size)
+				capa = _size;
+			if(capa < policy.min_capacity)
+				capa = policy.min_capacity;
+			if(capa >= _capacity)
+				return false;
+
+			size_type slack = capa - _size;
+			_learn_bias(0, 0);
+			try
+			{
+				_reallocate(_front_slack(slack), slack - _front_slack(slack));
+			}
+			catch(std::bad_alloc&)
+			{
+				// Shrinking is only an optimization, the tape is left unchanged.
+				return false;
+			}
+			return true;
+		}
+
 		/** \} */
 
 
 		/**
 		 * \name Element and data access
 		 * \{ */			
-		reference front() {return _start[0];}
-		const_reference front() const {return _start[0];}
-		reference back() {return _start[_size-1];}
-		const_reference back() const {return  _start[_size-1];}
-		reference operator[](size_type n) {return _start[n];}
-		const_reference operator[](size_type n) const {return _start[n];}
-		reference at(size_type n) {_check_range(n); return _start[n];}
-		const_reference at(size_type n) const {_check_range(n); return _start[n];}
-		pointer data() noexcept {return _start;}
-		const_pointer data() const noexcept {return _start;}
+		CONTAINER_TAPE_CONSTEXPR reference front() {return _start[0];}
+		CONTAINER_TAPE_CONSTEXPR const_reference front() const {return _start[0];}
+		CONTAINER_TAPE_CONSTEXPR reference back() {return _start[_size-1];}
+		CONTAINER_TAPE_CONSTEXPR const_reference back() const {return  _start[_size-1];}
+		CONTAINER_TAPE_CONSTEXPR reference operator[](size_type n) {return _start[n];}
+		CONTAINER_TAPE_CONSTEXPR const_reference operator[](size_type n) const {return _start[n];}
+		CONTAINER_TAPE_CONSTEXPR reference at(size_type n) {_check_range(n); return _start[n];}
+		CONTAINER_TAPE_CONSTEXPR const_reference at(size_type n) const {_check_range(n); return _start[n];}
+		CONTAINER_TAPE_CONSTEXPR pointer data() noexcept {return _start;}
+		CONTAINER_TAPE_CONSTEXPR const_pointer data() const noexcept {return _start;}
+
+		/** Returns a view of the len elements from position pos, or of all elements from pos if there are fewer.
+		 * The view is invalidated by any reallocation of the tape.
+		 * \throw std::out_of_range if pos is greater than size().
+		 */
+		tape_span<value_type> slice(size_type pos, size_type len)
+		{
+			_check_slice(pos, len);
+			return tape_span<value_type>(_start + pos, len);
+		}
+
+		tape_span<const value_type> slice(size_type pos, size_type len) const
+		{
+			_check_slice(pos, len);
+			return tape_span<const value_type>(_start + pos, len);
+		}
 		/** \} */
 
 
@@ -665,16 +1029,17 @@ namespace container
 		 * \{ */			
 
 		/** Assigns new contents to the tape, replacing its current contents, and modifying its size accordingly.*/
-		template <class InputIterator>
-		void assign(InputIterator first, InputIterator last)
+		template <class InputIterator, class = typename std::enable_if<tape_is_iterator<InputIterator>::value>::type>
+		CONTAINER_TAPE_CONSTEXPR void assign(InputIterator first, InputIterator last)
 		{
 			// Count the number of element to insert.
 			size_type n = 0;
 			for(InputIterator cur = first; cur != last; ++cur, ++n){}
-			if(n==0) n = 1;
 
 			// Destroy preceding elements if any
 			_destroy_all();
+			if(n==0)
+				return;
 			
 			// Ensure tape has enought space and set _start ptr at optimal place
 			if(_capacity < n)
@@ -687,28 +1052,30 @@ namespace container
 			}
 			else
 			{
-				_start = _base + ((_capacity - n) / 2);
+				_start = _base + _front_slack(_capacity - n);
+				_snapshot_slack();
 			}
 
 			// Copy elements
 			_size = n;
-			if(n == 1)
-			{
-				_construct(_start, *first);
-			}
-			else
+			pointer ptr = _start;
+			while(first != last)
 			{
-				pointer ptr = _start;
-				while(first != last)
-				{
-					_construct(ptr++, *first++);
-				}
+				_construct(ptr++, *first++);
 			}
 		}
 
 		/** Assigns new contents to the tape, replacing its current contents, and modifying its size accordingly.*/
-		void assign(size_type n, const value_type& val)
+		CONTAINER_TAPE_CONSTEXPR void assign(size_type n, const value_type& val)
 		{
+			// Value may be an element of the tape, destroyed below.
+			if(_contains(&val))
+			{
+				value_type tmp(val);
+				assign(n, tmp);
+				return;
+			}
+
 			// Destroy preceding elements if any
 			_destroy_all();
 			
@@ -723,129 +1090,169 @@ namespace container
 			}
 			else
 			{
-				_start = _base + ((_capacity - n) / 2);
+				_start = _base + _front_slack(_capacity - n);
+				_snapshot_slack();
 			}
 
 			// Copy elements
+			_fill_n(_start, n, val);
 			_size = n;
-			pointer ptr = _start;
-			while(n--)
-			{
-				_construct(ptr++, val);
-			}
 		}
 
 		/**
 		 * Replaces the contents of the container with the elements from the initializer list ilist.
 		 * \param ilist Initializer list to copy the values from.
 		 */
-		void assign(std::initializer_list<value_type> ilist)
+		CONTAINER_TAPE_CONSTEXPR void assign(std::initializer_list<value_type> ilist)
 		{
 			this->assign(ilist.begin(), ilist.end());
 		}
 
 		/** Adds a new element at the end of the tape, after its current last element. The content of val is copied to the new element. */
-		void push_back(const value_type& val)
+		CONTAINER_TAPE_CONSTEXPR void push_back(const value_type& val)
 		{
 			if(capacity_after() < 1)
-				reserve_after(64); // TODO Compute reservation size smarter.
+			{
+				// Value may be an element of the tape, moved by reallocation or sliding.
+				if(_contains(&val))
+				{
+					push_back(value_type(val));
+					return;
+				}
+				_grow(0, 1);
+			}
 			_construct(_start+_size++, val);
 		}
 
 		/** Adds n new elements at the end of the tape, after its current last element. The content of val is copied to the new element. */
-		void push_back(const value_type& val, size_type n)
+		CONTAINER_TAPE_CONSTEXPR void push_back(const value_type& val, size_type n)
 		{
 			if(capacity_after() < n)
-				reserve_after(n+64); // TODO Compute reservation size smarter.
-			while(n--)
-				_construct(_start+_size++, val);
+			{
+				// Value may be an element of the tape, moved by reallocation or sliding.
+				if(_contains(&val))
+				{
+					value_type tmp(val);
+					push_back(tmp, n);
+					return;
+				}
+				_grow(0, n);
+			}
+			_fill_n(_start + _size, n, val);
+			_size += n;
 		}
 
 		/** Adds new elements at the end of the tape, after its current last element. The content of val is copied to the new element. */
-		template <class InputIterator>			
-		void push_back(InputIterator first, InputIterator last)
+		template <class InputIterator, class = typename std::enable_if<tape_is_iterator<InputIterator>::value>::type>
+		CONTAINER_TAPE_CONSTEXPR void push_back(InputIterator first, InputIterator last)
 		{
 			for(;first != last; ++first)
 			{
 				if(capacity_after() < 1)
-					reserve_after(64); // TODO Compute reservation size smarter.
+					_grow(0, 1);
 				_construct(_start+(_size++), *first);
 			}
 		}
 
 		/** Adds a new element at the end of the tape, after its current last element. The content of val is moved to the new element. */
-		void push_back(value_type&& value)
+		CONTAINER_TAPE_CONSTEXPR void push_back(value_type&& value)
 		{
-			if(capacity_after() < 1)
-				reserve_after(64); // TODO Compute reservation size smarter.
-			_construct(_start+_size++, std::move(value));
+			emplace_back(std::move(value));
 		}
 
 		/** Adds a new element at the end of the tape, after its current last element. The new element is constructed emplace. */
 		template<class... Args>
 #if   __cplusplus < 201703L // (until C++17)
-		void
+		CONTAINER_TAPE_CONSTEXPR void
 #else // (since C++17)
-		reference
+		CONTAINER_TAPE_CONSTEXPR reference
 #endif
 		emplace_back(Args&&... args)
 		{
 			if(capacity_after() < 1)
-				reserve_after(64); // TODO Compute reservation size smarter.
-			_construct(_start+_size++, std::forward<Args>(args)...);
+			{
+				// Arguments may refer to elements of the tape, moved by reallocation or sliding.
+				value_type tmp(std::forward<Args>(args)...);
+				_grow(0, 1);
+				_construct(_start+_size++, std::move(tmp));
+			}
+			else
+				_construct(_start+_size++, std::forward<Args>(args)...);
 #if   __cplusplus >= 201703L // (since C++17)
 			return back();
 #endif
 		}
 
 		/** Removes the last element in the tape, effectively reducing the container size by one. */
-		void pop_back()
+		CONTAINER_TAPE_CONSTEXPR void pop_back()
 		{
 			if(_size>0)
 			{
 				_destroy(_start + --_size);
+				_track_slack();
+				_auto_shrink();
 			}
 		}
 
 		/** Removes the last n elements in the tape, effectively reducing the container size by n. */
-		void pop_back(size_type n)
+		CONTAINER_TAPE_CONSTEXPR void pop_back(size_type n)
 		{
-			while(_size>0 && n-->0)
-			{
-				_destroy(_start + --_size);
-			}
+			if(n > _size)
+				n = _size;
+			_size -= n;
+			_destroy_n(_start + _size, n);
+			_track_slack();
+			_auto_shrink();
 		}
 
 		/** Adds a new element at the begining of the tape, before its current first element. The content of val is copied to the new element. */
-		void push_front(const value_type& val)
+		CONTAINER_TAPE_CONSTEXPR void push_front(const value_type& val)
 		{
 			if(capacity_before() < 1)
-				reserve_before(64); // TODO Compute reservation size smarter.
+			{
+				// Value may be an element of the tape, moved by reallocation or sliding.
+				if(_contains(&val))
+				{
+					push_front(value_type(val));
+					return;
+				}
+				_grow(1, 0);
+			}
 			_construct(--_start, val);
 			++_size;
 		}
 
 		/** Adds n new elements at the begining of the tape, before its current first element. The content of val is copied to the new element. */
-		void push_front(const value_type& val, size_type n)
+		CONTAINER_TAPE_CONSTEXPR void push_front(const value_type& val, size_type n)
 		{
 			if(capacity_before() < n)
-				reserve_before(n + 64); // TODO Compute reservation size smarter.
+			{
+				// Value may be an element of the tape, moved by reallocation or sliding.
+				if(_contains(&val))
+				{
+					value_type tmp(val);
+					push_front(tmp, n);
+					return;
+				}
+				_grow(n, 0);
+			}
+			_fill_n(_start - n, n, val);
+			_start -= n;
 			_size += n;
-			while(n--)
-				_construct(--_start, val);
 		}
 
 		/** Adds new elements at the begining of the tape, before its current first element. The content of val is copied to the new element. */
-		template <class InputIterator>			
-		void push_front(InputIterator first, InputIterator last)
+		template <class InputIterator, class = typename std::enable_if<tape_is_iterator<InputIterator>::value>::type>
+		CONTAINER_TAPE_CONSTEXPR void push_front(InputIterator first, InputIterator last)
 		{
 			// Count the number of element to copy.
 			size_type n = 0;
 			for(InputIterator cur = first; cur != last; ++cur, ++n){}
-			if(n==0) n = 1;
+			if(n==0)
+				return;
 
-			if(capacity_before() < 1)
-				reserve_before(n + 64); // TODO Compute reservation size smarter.
+			if(capacity_before() < n)
+				_grow(n, 0);
 
 			_start -= n;
 			_size += n;
@@ -858,26 +1265,30 @@ namespace container
 		}
 
 		/** Adds a new element at the begining of the tape, before its current first element. The content of val is moved to the new element. */
-		void push_front(value_type&& value)
+		CONTAINER_TAPE_CONSTEXPR void push_front(value_type&& value)
 		{
-			if(capacity_before() < 1)
-				reserve_before(64); // TODO Compute reservation size smarter.
-			_construct(--_start, std::move(value));
-			++_size;
+			emplace_front(std::move(value));
 		}
 
 		/** Adds a new element at the begining of the tape, before its current first element. The new element is constructed emplace. */
 		template<class... Args>
 #if   __cplusplus < 201703L // (until C++17)
-		void
+		CONTAINER_TAPE_CONSTEXPR void
 #else // (since C++17)
-		reference
+		CONTAINER_TAPE_CONSTEXPR reference
 #endif
 		emplace_front(Args&&... args)
 		{
 			if(capacity_before() < 1)
-				reserve_before(64); // TODO Compute reservation size smarter.
-			_construct(--_start, std::forward<Args>(args)...);
+			{
+				// Arguments may refer to elements of the tape, moved by reallocation or sliding.
+				value_type tmp(std::forward<Args>(args)...);
+				_grow(1, 0);
+				_construct(_start - 1, std::move(tmp));
+			}
+			else
+				_construct(_start - 1, std::forward<Args>(args)...);
+			--_start;
 			++_size;
 #if   __cplusplus >= 201703L // (since C++17)
 			return front();
@@ -885,202 +1296,609 @@ namespace container
 		}
 
 		/** Removes the first element in the tape, effectively reducing the container size by one. */
-		void pop_front()
+		CONTAINER_TAPE_CONSTEXPR void pop_front()
 		{
 			if(_size>0)
 			{
 				_destroy(_start);
 				++_start;
 				--_size;
+				_track_slack();
+				_auto_shrink();
 			}
 		}
 
 		/** Removes the first n elements in the tape, effectively reducing the container size by n. */
-		void pop_front(size_type n)
+		CONTAINER_TAPE_CONSTEXPR void pop_front(size_type n)
 		{
-			while(_size>0 && n-->0)
-			{
-				_destroy(_start++);
-				--_size;
-			}
+			if(n > _size)
+				n = _size;
+			_destroy_n(_start, n);
+			_start += n;
+			_size  -= n;
+			_track_slack();
+			_auto_shrink();
 		}
 
-		/** The tape is extended by inserting new elements before the element at the specified position, effectively increasing the container size by the number of elements inserted. */
-		iterator insert(const_iterator position, const value_type& val)
+		/** Makes room for at least n elements after the last one, without constructing them.
+		 * Free slots can then be written directly, by read(2), recv or a decoder for example, and adopted as elements with commit_back().
+		 * Elements of non-trivial types must be constructed in the slots, by placement new or the allocator, before being adopted,
+		 * and the tape must not be modified in between.
+		 * \return Pointer to the first of the (at least) n free slots following the last element. It is invalidated by any other modification of the tape.
+		 */
+		CONTAINER_TAPE_CONSTEXPR pointer grow_back_uninitialized(size_type n)
 		{
-			// TODO Optimize me
-			
-			size_type pos = position - begin();
-			
-			// Ensure tape has enought memory
-			reserve_before(1);
+			if(capacity_after() < n)
+				_grow(0, n);
+			return _start + _size;
+		}
 
-			// Move elements before insertion iterator
-			_internal_move(_start-1, _start, _start + pos);
-			--_start;
-			++_size;
+		/** Adopts the k free slots following the last element as new elements, effectively increasing the container size by k.
+		 * Slots must have been written, or hold constructed elements for non-trivial types, after a call to grow_back_uninitialized().
+		 * \throw std::out_of_range if k exceeds capacity_after().
+		 */
+		CONTAINER_TAPE_CONSTEXPR void commit_back(size_type k)
+		{
+			if(k > capacity_after())
+				throw std::out_of_range("tape::commit_back");
+			_size += k;
+		}
 
-			// Insert element
-			_construct(_start + pos, val);
+		/** Makes room for at least n elements before the first one, without constructing them.
+		 * Like with grow_back_uninitialized(), elements of non-trivial types must be constructed in the slots before being adopted.
+		 * \return Pointer to the first of the n free slots preceding the first element, these slots are [ptr, ptr+n). It is invalidated by any other modification of the tape.
+		 */
+		CONTAINER_TAPE_CONSTEXPR pointer grow_front_uninitialized(size_type n)
+		{
+			if(capacity_before() < n)
+				_grow(n, 0);
+			return _start - n;
+		}
 
-			return iterator(_start + pos);
+		/** Adopts the k free slots preceding the first element as new elements, effectively increasing the container size by k.
+		 * These are the last k slots of the range returned by grow_front_uninitialized(), the ones adjacent to the first element.
+		 * \throw std::out_of_range if k exceeds capacity_before().
+		 */
+		CONTAINER_TAPE_CONSTEXPR void commit_front(size_type k)
+		{
+			if(k > capacity_before())
+				throw std::out_of_range("tape::commit_front");
+			_start -= k;
+			_size  += k;
 		}
 
-		/** The tape is extended by inserting a new moved element before the element at the specified position, effectively increasing the container size by the number of elements inserted. */
-		iterator insert(const_iterator position, value_type&& val)
+		/** The tape is extended by inserting new elements before the element at the specified position, effectively increasing the container size by the number of elements inserted.
+		 * Elements on the shortest side of the position are shifted toward the free slots of their end.
+		 */
+		CONTAINER_TAPE_CONSTEXPR iterator insert(const_iterator position, const value_type& val)
 		{
-			// TODO Optimize me
+			size_type pos = position - cbegin();
 
-			size_type pos = position - begin();
+			// Inserted value may be an element of the tape, which can be moved by shifting.
+			if(_contains(&val))
+				return emplace(position, val);
 
-			// Ensure tape has enought memory
-			reserve_before(1);
+			// Open room for the element and insert it
+			pointer ptr = _open_gap(pos, 1);
+			_construct(ptr, val);
 
-			// Move elements before insertion iterator
-			_internal_move(_start-1, _start, _start + pos);
-			--_start;
-			++_size;
+			return iterator(ptr);
+		}
+
+		/** The tape is extended by inserting a new moved element before the element at the specified position, effectively increasing the container size by the number of elements inserted. */
+		CONTAINER_TAPE_CONSTEXPR iterator insert(const_iterator position, value_type&& val)
+		{
+			size_type pos = position - cbegin();
 
-			// Insert element
-			_construct(_start + pos, std::move(val));
+			// Open room for the element and insert it
+			pointer ptr = _open_gap(pos, 1);
+			_construct(ptr, std::move(val));
 
-			return iterator(_start + pos);
+			return iterator(ptr);
 		}
 
 		/** The tape is extended by inserting a new constructed element before the element at the specified position, effectively increasing the container size by the number of elements inserted. The element is created emplaced.*/
 		template< class... Args >
-		iterator emplace(const_iterator position, Args&&... args)
+		CONTAINER_TAPE_CONSTEXPR iterator emplace(const_iterator position, Args&&... args)
 		{
-			// TODO Optimize me
-
-			size_type pos = position - begin();
+			size_type pos = position - cbegin();
 
-			// Ensure tape has enought memory
-			reserve_before(1);
-
-			// Move elements before insertion iterator
-			_internal_move(_start-1, _start, _start + pos);
-			--_start;
-			++_size;
-
-			// Insert element
-			_construct(_start + pos, std::forward<Args>(args)...);
+			// Arguments which may refer to elements of the tape are copied before growth by emplace_front and emplace_back.
+			if(pos == 0)
+			{
+				emplace_front(std::forward<Args>(args)...);
+			}
+			else if(pos == _size)
+			{
+				emplace_back(std::forward<Args>(args)...);
+			}
+			else
+			{
+				// Arguments may refer to elements of the tape, which can be moved by shifting.
+				value_type tmp(std::forward<Args>(args)...);
+				_construct(_open_gap(pos, 1), std::move(tmp));
+			}
 
 			return iterator(_start + pos);
 		}
 
 
 		/** The tape is extended by inserting new elements before the element at the specified position, effectively increasing the container size by the number of elements inserted. */
-		iterator insert (const_iterator position, size_type count, const value_type& val)
+		CONTAINER_TAPE_CONSTEXPR iterator insert (const_iterator position, size_type count, const value_type& val)
 		{
-			// TODO Optimize me
-
-			size_type pos = position - begin();
+			size_type pos = position - cbegin();
 
-			// Ensure tape has enought memory
-			reserve_before(count);
-
-			// Move elements before insertion iterator
-			_internal_move(_start-count, _start, _start + pos);
-			_start -= count;
-			_size  += count;
+			if(count > 0)
+			{
+				// Inserted value may be an element of the tape, which can be moved by shifting.
+				if(_contains(&val))
+				{
+					value_type tmp(val);
+					return insert(position, count, tmp);
+				}
 
-			// Insert elements
-			for(pointer ptr = _start + pos; ptr < _start + pos + count; ++ptr)
-				_construct(ptr, val);
+				// Open room for elements and insert them
+				_fill_n(_open_gap(pos, count), count, val);
+			}
 
 			return iterator(_start + pos);
 		}
 
 		/** The tape is extended by inserting new elements before the element at the specified position, effectively increasing the container size by the number of elements inserted. */
-		template <class InputIterator>
-		iterator insert (const_iterator position, InputIterator first, InputIterator last)
+		template <class InputIterator, class = typename std::enable_if<tape_is_iterator<InputIterator>::value>::type>
+		CONTAINER_TAPE_CONSTEXPR iterator insert (const_iterator position, InputIterator first, InputIterator last)
 		{
-			// TODO Optimize me
-
-			size_type pos = position - begin();
+			size_type pos = position - cbegin();
 
 			// Count the number of element to copy.
 			size_type n = 0;
 			for(InputIterator cur = first; cur != last; ++cur, ++n){}
 			if(n>0)
 			{
-				// Ensure tape has enought memory
-				reserve_before(n);
-
-				// Move elements before insertion iterator
-				_internal_move(_start-n, _start, _start + pos);
-				_start -= n;
-				_size  += n;
-				
-				// Insert elements
-				for(pointer ptr = _start + pos; first != last; ++ptr, first++)
+				// Open room for elements and insert them
+				for(pointer ptr = _open_gap(pos, n); first != last; ++ptr, ++first)
 					_construct(ptr, *first);
 			}
 			return iterator(_start + pos);
 		}
 
 		/** Inserts elements from initializer list ilist before pos.*/
-		iterator insert(const_iterator position, std::initializer_list<value_type> ilist)
+		CONTAINER_TAPE_CONSTEXPR iterator insert(const_iterator position, std::initializer_list<value_type> ilist)
 		{
 			return this->insert(position, ilist.begin(), ilist.end());
 		}
 
-		/** Removes element from the tape. */
-		iterator erase(const_iterator position)
+		/** Inserts many elements at once, each before the element at its position in the tape as it was before the call.
+		 * Elements given for the same position are inserted in the given order.
+		 *
+		 * The batch is split in two: elements before the split are inserted by shifting preceding elements toward the front slack,
+		 * elements after it by shifting following elements toward the back slack. The split minimizing moves is chosen among those fitting in current slack.
+		 * If none fits, the tape grows once and elements are moved to the new storage directly at their final place.
+		 * Either way, every element of the tape is moved at most once.
+		 *
+		 * If a value copy throws, shifted elements are moved back and the tape is left unchanged, provided moves of elements do not throw.
+		 *
+		 * \param first,last Range of pairs (position, value), sorted by position. Values are copied, or moved through std::move_iterator.
+		 * \throw std::out_of_range if a position is greater than size(). The tape is then left unchanged.
+		 */
+		template <class BidirectionalIterator>
+		CONTAINER_TAPE_CONSTEXPR void insert_batch(BidirectionalIterator first, BidirectionalIterator last)
 		{
-			// TODO Optimize me by testing if erased element is first or last one.
+			if(first == last)
+				return;
+
+			size_type k = std::distance(first, last);
+			if((size_type)(*std::prev(last)).first > _size)
+				throw std::out_of_range("tape::insert_batch");
+
+			// Find the split moving the fewest elements among those fitting in slack.
+			// Inserting the m first elements moves the elements before the (m-1)-th position,
+			// inserting the others moves the elements from the m-th position.
+			size_type m = 0, best = 0, prev = 0, j = 0;
+			bool fits = false;
+			BidirectionalIterator split = first;
+			for(BidirectionalIterator it = first; ; ++it, ++j)
+			{
+				size_type pos = it != last ? (size_type)(*it).first : _size;
+				size_type cost = prev + (_size - pos);
+				if(j <= capacity_before() && k - j <= capacity_after() && (!fits || cost < best))
+				{
+					m = j;
+					best = cost;
+					split = it;
+					fits = true;
+				}
+				prev = pos;
+				if(it == last)
+					break;
+			}
 
-			pointer ptr = position.get_ptr();
+			if(!fits)
+			{
+				_insert_batch_reallocate(first, last, k);
+				return;
+			}
 
-			// Destroy erased element
-			_destroy(ptr);
-			
-			// Move content
-			_internal_move(ptr, ptr+1, end().get_ptr());
+			Stats::on_move(best);
+			pointer old_start = _start, old_end = _start + _size;
+			pointer dst = _start - m;
+			pointer src = _start;
+			BidirectionalIterator it = first;
+			size_type i = 0;
+			bool back = false;
+			try
+			{
+				// Front part: from the first element, shift blocks toward the front slack, each by the number of insertions after it.
+				for(; it != split; ++it, ++i)
+				{
+					pointer stop = old_start + (*it).first;
+					for(; src != stop && dst < old_start; ++src, ++dst)
+						_construct(dst, std::move(*src));
+					dst = std::move(src, stop, dst);
+					src = stop;
+					if(dst < old_start)
+						_construct(dst, (*it).second);
+					else
+						*dst = (*it).second;
+					++dst;
+				}
 
-			--_size;
+				// Back part: from the last element, shift blocks toward the back slack, each by the number of insertions before it.
+				back = true;
+				dst = old_end + (k - m);
+				src = old_end;
+				it = last;
+				i = k;
+				while(it != split)
+				{
+					--it, --i;
+					pointer stop = old_start + (*it).first;
+					while(src != stop && dst > old_end)
+						_construct(--dst, std::move(*--src));
+					dst = std::move_backward(stop, src, dst);
+					src = stop;
+					--dst;
+					if(dst >= old_end)
+						_construct(dst, (*it).second);
+					else
+						*dst = (*it).second;
+				}
+			}
+			catch(...)
+			{
+				// A value copy threw after the blocks of insertion i were shifted: shift them back and destroy what was constructed in slack.
+				if(back)
+				{
+					_undo_batch_back(it, last, i, k, m, old_start, dst + 1);
+					if(m > 0)
+						_undo_batch_front(std::prev(split), m - 1, m, old_start, old_start);
+				}
+				else
+					_undo_batch_front(it, i, m, old_start, dst);
+				throw;
+			}
 
-			return iterator(ptr);
+			_start -= m;
+			_size  += k;
 		}
 
-		/** Removes range of elements ([first,last)) from the tape. */
-		iterator erase(const_iterator first, const_iterator last)
+		/** Inserts many elements at once, from a list of pairs (position, value) sorted by position.
+		 * \see insert_batch(BidirectionalIterator, BidirectionalIterator)
+		 */
+		CONTAINER_TAPE_CONSTEXPR void insert_batch(std::initializer_list<std::pair<size_type, value_type> > ilist)
 		{
-			// TODO Optimize me by testing if erased elements are first or last ones.
+			insert_batch(ilist.begin(), ilist.end());
+		}
+
+		/** Removes element from the tape.
+		 * Elements on the shortest side of the position are shifted to fill the hole.
+		 */
+		CONTAINER_TAPE_CONSTEXPR iterator erase(const_iterator position)
+		{
+			return erase(position, position + 1);
+		}
+
+		/** Removes range of elements ([first,last)) from the tape.
+		 * Elements on the shortest side of the range are shifted to fill the hole.
+		 */
+		CONTAINER_TAPE_CONSTEXPR iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type pos = first - cbegin();
 			if(first != last)
 			{
 				size_type nb = last - first;
 
-				// Destroy all erased elements
-				for(const_iterator cur = first; cur != last; ++cur)
-					_destroy(cur.get_ptr());
-
-				// Move content
-				_internal_move(first.get_ptr(), last.get_ptr(), _start + _size);
+				if(pos < _size - pos - nb)
+				{
+					// Shift preceding elements forward, then destroy the nb first slots (moved-from or erased).
+					Stats::on_move(pos);
+					std::move_backward(_start, _start + pos, _start + pos + nb);
+					_destroy_n(_start, nb);
+					_start += nb;
+				}
+				else
+				{
+					// Shift following elements backward, then destroy the nb last slots (moved-from or erased).
+					Stats::on_move(_size - pos - nb);
+					std::move(_start + pos + nb, _start + _size, _start + pos);
+					_destroy_n(_start + _size - nb, nb);
+				}
 
 				_size -= nb;
+				_track_slack();
+				_auto_shrink();
+			}
+			return iterator(_start + pos);
+		}
+
+		/** Removes all elements for which pred returns true, in a single pass.
+		 * Kept elements are compacted toward the end of the tape needing the fewest moves:
+		 * only elements between the first and last removed ones, plus the elements on the shortest side of them, are shifted.
+		 * Then removed elements are destroyed in bulk.
+		 * pred is called exactly once per element, in an unspecified order.
+		 * \return Number of removed elements.
+		 */
+		template <class Predicate>
+		CONTAINER_TAPE_CONSTEXPR size_type remove_if(Predicate pred)
+		{
+			pointer first = _start, last = _start + _size;
+			pointer lo = first;
+			while(lo != last && !pred(*lo))
+				++lo;
+			if(lo == last)
+				return 0;
+			pointer hi = last - 1;
+			while(hi != lo && !pred(*hi))
+				--hi;
+
+			// lo and hi are the first and last removed elements.
+			size_type moved = 0, removed;
+			if(lo - first < last - 1 - hi)
+			{
+				// Compact toward the back, then destroy the removed slots at front.
+				pointer dst = hi;
+				if(hi != lo)
+				{
+					for(pointer src = hi - 1; src != lo; --src)
+					{
+						if(!pred(*src))
+						{
+							*dst-- = std::move(*src);
+							++moved;
+						}
+					}
+				}
+				moved += lo - first;
+				removed = std::move_backward(first, lo, dst + 1) - first;
+				_destroy_n(first, removed);
+				_start += removed;
+			}
+			else
+			{
+				// Compact toward the front, then destroy the removed slots at back.
+				pointer dst = lo;
+				for(pointer src = lo + 1; src < hi; ++src)
+				{
+					if(!pred(*src))
+					{
+						*dst++ = std::move(*src);
+						++moved;
+					}
+				}
+				moved += last - 1 - hi;
+				dst = std::move(hi + 1, last, dst);
+				removed = last - dst;
+				_destroy_n(dst, removed);
+			}
+
+			Stats::on_move(moved);
+			_size -= removed;
+			_track_slack();
+			_auto_shrink();
+			return removed;
+		}
+
+		/** Removes the elements at the given positions, in a single pass.
+		 * Kept elements are compacted toward the end of the tape needing the fewest moves, each of them is moved at most once.
+		 * Then removed elements are destroyed in bulk.
+		 * \param first,last Range of positions, sorted in ascending order. A position may appear several times.
+		 * \throw std::out_of_range if a position is not lower than size(). The tape is then left unchanged.
+		 * \return Number of removed elements.
+		 */
+		template <class BidirectionalIterator>
+		CONTAINER_TAPE_CONSTEXPR size_type erase_indices(BidirectionalIterator first, BidirectionalIterator last)
+		{
+			if(first == last)
+				return 0;
+			BidirectionalIterator back = std::prev(last);
+			size_type lo = *first, hi = *back;
+			if(hi >= _size)
+				throw std::out_of_range("tape::erase_indices");
+
+			size_type removed;
+			if(lo < _size - 1 - hi)
+			{
+				// Compact toward the back, block by block from the last one, then destroy the removed slots at front.
+				pointer dst = _start + hi + 1;
+				size_type prev = hi;
+				for(BidirectionalIterator it = back; it != first; )
+				{
+					size_type pos = *--it;
+					if(pos == prev)
+						continue;
+					dst = std::move_backward(_start + pos + 1, _start + prev, dst);
+					prev = pos;
+				}
+				dst = std::move_backward(_start, _start + lo, dst);
+				removed = dst - _start;
+				Stats::on_move(hi + 1 - removed);
+				_destroy_n(_start, removed);
+				_start += removed;
+			}
+			else
+			{
+				// Compact toward the front, block by block from the first one, then destroy the removed slots at back.
+				pointer dst = _start + lo;
+				size_type prev = lo;
+				for(BidirectionalIterator it = std::next(first); it != last; ++it)
+				{
+					size_type pos = *it;
+					if(pos == prev)
+						continue;
+					dst = std::move(_start + prev + 1, _start + pos, dst);
+					prev = pos;
+				}
+				dst = std::move(_start + hi + 1, _start + _size, dst);
+				removed = _start + _size - dst;
+				Stats::on_move(_size - lo - removed);
+				_destroy_n(dst, removed);
+			}
+
+			_size -= removed;
+			_track_slack();
+			_auto_shrink();
+			return removed;
+		}
+
+		/** Splits the tape at position pos: elements from pos are removed from the tape and returned in a new tape.
+		 * Only the elements of the shortest side are moved: if the returned part is the longest one,
+		 * the returned tape takes over the storage and the kept elements are moved to new storage.
+		 * \throw std::out_of_range if pos is greater than size().
+		 * If an allocation throws, the tape is left unchanged.
+		 * \return Tape of the elements from pos, using a copy of the allocator and of the shrink policy of the tape.
+		 */
+		CONTAINER_TAPE_CONSTEXPR tape split(size_type pos)
+		{
+			if(pos > _size)
+				throw std::out_of_range("tape::split");
+			size_type tail = _size - pos;
+
+			tape res(_alloc);
+			static_cast<Shrink&>(res) = static_cast<const Shrink&>(*this);
+			if(tail <= pos)
+			{
+				// Move the tail out
+				if(tail > 0)
+				{
+					res.reserve_after(tail);
+					_internal_move(res._start, _start + pos, tail);
+					res._size = tail;
+					_size = pos;
+				}
+			}
+			else if(pos == 0)
+				res._steal(*this);
+			else
+			{
+				// Allocate the storage of the head first, so the tape is unchanged if it throws,
+				// then move the head to it and hand the old storage over.
+				pointer mem = std::allocator_traits<allocator_type>::allocate(_alloc, pos, _base);
+				Stats::on_reallocate();
+				Stats::on_allocate(pos, pos * sizeof(value_type));
+				_internal_move(mem, _start, pos);
+				res._steal(*this);
+				res._start += pos;
+				res._size  -= pos;
+				_base = _start = mem;
+				_capacity = _size = pos;
+				_snapshot_slack();
+			}
+			_track_slack();
+			res._track_slack();
+			_auto_shrink();
+			return res;
+		}
+
+		/** Moves the elements of other at the end of the tape, leaving other empty.
+		 * Only the elements of the shortest tape are moved: if other is the longest one, and allocators compare equal,
+		 * elements of the tape are moved before those of other, whose storage is taken over.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void append(tape&& other)
+		{
+			if(&other == this || other.empty())
+				return;
+			if(other._size <= _size || !(_alloc == other._alloc))
+			{
+				if(capacity_after() < other._size)
+					_grow(0, other._size);
+				_internal_move(_start + _size, other._start, other._size);
+				_size += other._size;
+				other._size = 0;
+				other._destroy_all();
+			}
+			else
+			{
+				if(other.capacity_before() < _size)
+					other._grow(_size, 0);
+				_internal_move(other._start - _size, _start, _size);
+				other._start -= _size;
+				other._size  += _size;
+				_size = 0;
+				_deallocate();
+				_steal(other);
+			}
+			_track_slack();
+			other._track_slack();
+		}
+
+		/** Moves the elements of other at the begining of the tape, leaving other empty.
+		 * Only the elements of the shortest tape are moved: if other is the longest one, and allocators compare equal,
+		 * elements of the tape are moved after those of other, whose storage is taken over.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void prepend(tape&& other)
+		{
+			if(&other == this || other.empty())
+				return;
+			if(other._size <= _size || !(_alloc == other._alloc))
+			{
+				if(capacity_before() < other._size)
+					_grow(other._size, 0);
+				_start -= other._size;
+				_internal_move(_start, other._start, other._size);
+				_size += other._size;
+				other._size = 0;
+				other._destroy_all();
+			}
+			else
+			{
+				if(other.capacity_after() < _size)
+					other._grow(0, _size);
+				_internal_move(other._start + other._size, _start, _size);
+				other._size += _size;
+				_size = 0;
+				_deallocate();
+				_steal(other);
 			}
-			return iterator(first.get_ptr());
+			_track_slack();
+			other._track_slack();
 		}
 
-		/** Exchanges the content of the container by the content of x, which is another tape object of the same type. Sizes may differ.*/
-		void swap(tape& x)
+		/** Exchanges the content of the container by the content of x, which is another tape object of the same type. Sizes may differ.
+		 * Allocators are exchanged only if they propagate on swap (see std::allocator_traits::propagate_on_container_swap),
+		 * otherwise they must compare equal.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void swap(tape& x)
 #if   __cplusplus >= 201703L // (since C++17)
-		noexcept // TODO Review this
+		noexcept(alloc_traits::propagate_on_container_swap::value || alloc_traits::is_always_equal::value)
 #endif
 		{
-			std::swap(_alloc,    x._alloc);
+			_swap_alloc(x._alloc, typename alloc_traits::propagate_on_container_swap());
 			std::swap(_base,     x._base);
 			std::swap(_start,    x._start);
 			std::swap(_size,     x._size);
 			std::swap(_capacity, x._capacity);
+			std::swap(_bias,     x._bias);
 		}
 
 		/** Removes all elements from the tape (which are destroyed), leaving the container with a size of 0. */
-		void clear() noexcept
+		CONTAINER_TAPE_CONSTEXPR void clear() noexcept
 		{
 			_destroy_all();
+			_track_slack();
+			// Shrinking an empty tape does not need to allocate, unless a minimal capacity is kept.
+			const tape_shrink_policy policy = _shrink();
+			if(policy.enabled() && !policy.deferred && policy.min_capacity == 0)
+				_deallocate();
 		}
 
 		/** \} */
@@ -1090,38 +1908,63 @@ namespace container
 		 * \name Allocator 
 		 * \{ */
 		/** Returns a copy of the allocator object associated with the tape. */
-		allocator_type get_allocator() const
+		CONTAINER_TAPE_CONSTEXPR allocator_type get_allocator() const
 		{
 			return _alloc;
 		}
 			
 		/** \} */
 
-		// TODO Add external relational operators.
+		/**
+		 * \name Statistics
+		 * \{ */
+		/** Returns the statistics recorded for this tape by its statistics policy. */
+		CONTAINER_TAPE_CONSTEXPR const stats_type& stats() const noexcept
+		{
+			return *this;
+		}
+
+		/** Returns the statistics recorded for this tape by its statistics policy. */
+		CONTAINER_TAPE_CONSTEXPR stats_type& stats() noexcept
+		{
+			return *this;
+		}
+		/** \} */
 
 	private:
 			
 		/** Check if there is enought allocated memory and throw except if not. Used by tape::at(). */ 
-		void _check_range(size_type n) const
+		CONTAINER_TAPE_CONSTEXPR void _check_range(size_type n) const
 		{
 			//If n is out of range, throw an out_of_range exception
 			if (n >= size())
 				throw std::out_of_range("tape::at");
 		}
 
-		/** Allocate memory and set pointers to first third of it.
+		CONTAINER_TAPE_CONSTEXPR void _check_slice(size_type pos, size_type& len) const
+		{
+			if (pos > size())
+				throw std::out_of_range("tape::slice");
+			if (len > size() - pos)
+				len = size() - pos;
+		}
+
+		/** Allocate memory for 3 times size elements and set start pointer to split the 2*size free slots according to learned bias.
 		 * Assume no memory is allocated.
 		 */
-		void _allocate(size_type size)
+		CONTAINER_TAPE_CONSTEXPR void _allocate(size_type size)
 		{
 			_capacity = 3*size;
 			_base  = std::allocator_traits<allocator_type>::allocate(_alloc, _capacity);
-			_start = _base + size;
+			_start = _base + _front_slack(2*size);
 			_size  = 0;
+			_snapshot_slack();
+			Stats::on_allocate(_capacity, _capacity * sizeof(value_type));
+			_track_slack();
 		}
 
 		/** Release allocated memory. Assume no element is assigned. */
-		void _deallocate()
+		CONTAINER_TAPE_CONSTEXPR void _deallocate()
 		{
 			if(_capacity)
 			{
@@ -1133,61 +1976,281 @@ namespace container
 
 		/** Construct an element. */
 		template<class... Args>
-		void _construct(value_type* p, Args&&... args)
+		CONTAINER_TAPE_CONSTEXPR void _construct(value_type* p, Args&&... args)
 		{
 			std::allocator_traits<allocator_type>::construct(_alloc, p, std::forward<Args>(args)...);
 		}
 
 		/** Destroy an element. */
-		void _destroy(value_type* p)
+		CONTAINER_TAPE_CONSTEXPR void _destroy(value_type* p)
 		{
 			std::allocator_traits<allocator_type>::destroy(_alloc, p);
 		}
 			
-		/** Destroy n contigous elements. */
-		void _destroy_n(value_type* p, size_type n)
+		/** Destroy n contigous elements. Nothing is done for elements needing no destruction. */
+		CONTAINER_TAPE_CONSTEXPR void _destroy_n(value_type* p, size_type n)
+		{
+			if(!_trivial_destroy::value)
+			{
+				for(;n--;++p)
+					std::allocator_traits<allocator_type>::destroy(_alloc, p);
+			}
+		}
+
+		/** Tell if the calling code is evaluated in a constant expression, where bytewise operations are not available. */
+		static CONTAINER_TAPE_CONSTEXPR bool _constant_evaluated()
 		{
-			for(;n--;++p)
-				std::allocator_traits<allocator_type>::destroy(_alloc, p);
+#ifdef CONTAINER_TAPE_HAS_CONSTEXPR
+			return std::is_constant_evaluated();
+#else
+			return false;
+#endif
+		}
+
+		/** Construct n copies of val in the uninitialized slots from p.
+		 * If a construction throws, already constructed elements are destroyed.
+		 * val must not be an element of the tape moved by an eventual reallocation before the call.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _fill_n(pointer p, size_type n, const value_type& val)
+		{
+			_fill_n(p, n, val, _bitwise());
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void _fill_n(pointer p, size_type n, const value_type& val, std::true_type)
+		{
+			if(_constant_evaluated())
+				_fill_n(p, n, val, std::false_type());
+			else
+				std::uninitialized_fill_n(p, n, val); // memset or vectorized loop
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void _fill_n(pointer p, size_type n, const value_type& val, std::false_type)
+		{
+			size_type k = 0;
+			try
+			{
+				for(; k < n; ++k)
+					_construct(p + k, val);
+			}
+			catch(...)
+			{
+				_destroy_n(p, k);
+				throw;
+			}
+		}
+
+		/** Value-initialize n elements in the uninitialized slots from p.
+		 * If a construction throws, already constructed elements are destroyed.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _value_construct_n(pointer p, size_type n)
+		{
+			_value_construct_n(p, n, _bitwise());
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void _value_construct_n(pointer p, size_type n, std::true_type)
+		{
+			_fill_n(p, n, value_type(), std::true_type());
+		}
+
+		CONTAINER_TAPE_CONSTEXPR void _value_construct_n(pointer p, size_type n, std::false_type)
+		{
+			size_type k = 0;
+			try
+			{
+				for(; k < n; ++k)
+					_construct(p + k);
+			}
+			catch(...)
+			{
+				_destroy_n(p, k);
+				throw;
+			}
 		}
 			
 		/** Destroy all elements in the tape and set size to 0. */
-		void _destroy_all()
+		CONTAINER_TAPE_CONSTEXPR void _destroy_all()
 		{
+			_learn_bias(0, 0);
 			_destroy_n(_start, _size);
 			_size = 0;
-			// TODO Reset start pointer to middle of allocated space ?
+			// Reset start pointer according to learned bias
+			_start = _base + _front_slack(_capacity);
+			_snapshot_slack();
 		}
 
-		/** Move elements from a place to another. No allocation is done. */
-		void _internal_move(pointer dst, pointer src, size_type n = 1)
+		/** Propagate allocator, depending on allocator traits. */
+		CONTAINER_TAPE_CONSTEXPR void _assign_alloc(const allocator_type& alloc, std::true_type) {_alloc = alloc;}
+		CONTAINER_TAPE_CONSTEXPR void _assign_alloc(const allocator_type&, std::false_type) {}
+		CONTAINER_TAPE_CONSTEXPR void _move_alloc(allocator_type& alloc, std::true_type) {_alloc = std::move(alloc);}
+		CONTAINER_TAPE_CONSTEXPR void _move_alloc(allocator_type&, std::false_type) {}
+		CONTAINER_TAPE_CONSTEXPR void _swap_alloc(allocator_type& alloc, std::true_type) {using std::swap; swap(_alloc, alloc);}
+		CONTAINER_TAPE_CONSTEXPR void _swap_alloc(allocator_type&, std::false_type) {}
+
+		/** Take over the storage of other, leaving it empty. Assume no memory is allocated. */
+		CONTAINER_TAPE_CONSTEXPR void _steal(tape& other)
 		{
-			while(n--)
+			_base     = other._base;
+			_start    = other._start;
+			_size     = other._size;
+			_capacity = other._capacity;
+			_bias     = other._bias;
+			other._base = other._start = nullptr;
+			other._size = other._capacity = 0;
+			other._bias &= _bias_share;
+		}
+
+		/** Applies the shrink policy after a removal, unless it is deferred.
+		 * A sliding tape which becomes empty restarts from the place given by its learned bias, nothing has to be moved.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _auto_shrink()
+		{
+			if(_size == 0 && _shrink().slides() && _base)
 			{
-				// TODO Optimize this (use of std::uninitialized_copy ?)
-				_construct(dst++, *src);
-				std::allocator_traits<allocator_type>::destroy(_alloc, src++);
+				_learn_bias(0, 0);
+				_start = _base + _front_slack(_capacity);
+				_snapshot_slack();
 			}
+			if(_shrink().enabled() && !_shrink().deferred)
+				maybe_shrink();
 		}
 
-		/** Move elements from a place to another. No allocation is done. */
-		void _internal_move(pointer dst, pointer src_begin, pointer src_end)
+		/** Returns the settings of the shrink policy, constants for tape_no_shrink. */
+		CONTAINER_TAPE_CONSTEXPR tape_shrink_policy _shrink() const
 		{
-			while(src_begin!=src_end)
+			return Shrink::get();
+		}
+
+		/** Notify statistics policy of current slack sizes. Called where slack may grow. */
+		CONTAINER_TAPE_CONSTEXPR void _track_slack()
+		{
+			Stats::on_slack(capacity_before(), capacity_after());
+		}
+
+		/** Tell if a pointer refers to an element of the tape. */
+		CONTAINER_TAPE_CONSTEXPR bool _contains(const value_type* p) const
+		{
+#ifdef CONTAINER_TAPE_HAS_CONSTEXPR
+			// Pointers to different objects can not be ordered in constant expressions, only compared for equality.
+			if(std::is_constant_evaluated())
 			{
-				// TODO Optimize this (use of std::uninitialized_copy ?)
-				_construct(dst++, *src_begin);
-				std::allocator_traits<allocator_type>::destroy(_alloc, src_begin++);
+				for(size_type n = 0; n < _size; ++n)
+					if(p == _start + n)
+						return true;
+				return false;
 			}
+#endif
+			return !std::less<const value_type*>()(p, _start) && std::less<const value_type*>()(p, _start + _size);
+		}
+
+		/** Open a gap of n uninitialized slots before the element at index pos, increasing size by n.
+		 * The elements of the shortest side are shifted, toward the free slots of their end, which are grown if needed.
+		 * \return Pointer to the first slot of the gap.
+		 */
+		CONTAINER_TAPE_CONSTEXPR pointer _open_gap(size_type pos, size_type n)
+		{
+			if(pos < _size - pos)
+			{
+				if(capacity_before() < n)
+					_grow(n, 0);
+				pointer first = _start;
+				_start -= n;
+				_move_left(_start, first, first + pos);
+			}
+			else
+			{
+				if(capacity_after() < n)
+					_grow(0, n);
+				_move_right(_start + pos, _start + _size, _start + _size + n);
+			}
+			_size += n;
+			return _start + pos;
+		}
+
+		/** Shift elements of [first, last) to dst, before first, slots of [dst, first) being uninitialized.
+		 * Elements moved to uninitialized slots are move-constructed, others are move-assigned.
+		 * Moved-from slots which are not overwritten are destroyed.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _move_left(pointer dst, pointer first, pointer last)
+		{
+			Stats::on_move(last - first);
+			if(_bitwise::value && !_constant_evaluated())
+			{
+				_memmove(dst, first, last - first, _bitwise());
+				return;
+			}
+			pointer src = first;
+			for(; dst != first && src != last; ++dst, ++src)
+				_construct(dst, std::move(*src));
+			dst = std::move(src, last, dst);
+			pointer dead = dst < first ? first : dst;
+			_destroy_n(dead, last - dead);
+		}
+
+		/** Shift elements of [first, last) to end at d_last, after last, slots of [last, d_last) being uninitialized.
+		 * Elements moved to uninitialized slots are move-constructed, others are move-assigned.
+		 * Moved-from slots which are not overwritten are destroyed.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _move_right(pointer first, pointer last, pointer d_last)
+		{
+			Stats::on_move(last - first);
+			if(_bitwise::value && !_constant_evaluated())
+			{
+				_memmove(d_last - (last - first), first, last - first, _bitwise());
+				return;
+			}
+			pointer src = last;
+			while(d_last != last && src != first)
+				_construct(--d_last, std::move(*--src));
+			d_last = std::move_backward(first, src, d_last);
+			pointer dead = d_last > last ? last : d_last;
+			_destroy_n(first, dead - first);
+		}
+
+		/** Copy n elements bytewise from src to dst, ranges may overlap. Only for bitwise elements.
+		 * Bounding n by max_size() lets the compiler know the byte count fits an object.
+		 */
+		void _memmove(pointer dst, pointer src, size_type n, std::true_type)
+		{
+			if(n > 0 && n <= max_size())
+				std::memmove(dst, src, n * sizeof(value_type));
+		}
+
+		void _memmove(pointer, pointer, size_type, std::false_type) {}
+
+		/** Move elements from a place to another, to uninitialized slots of another storage, and destroy moved-from elements.
+		 * Bitwise elements are relocated with a single memcpy. No allocation is done.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _internal_move(pointer dst, pointer src, size_type n = 1)
+		{
+			Stats::on_move(n);
+			if(_bitwise::value && !_constant_evaluated())
+			{
+				_memmove(dst, src, n, _bitwise());
+				return;
+			}
+			while(n--)
+			{
+				_construct(dst++, std::move_if_noexcept(*src));
+				std::allocator_traits<allocator_type>::destroy(_alloc, src++);
+			}
+		}
+
+		/** Move elements from a place to another, to uninitialized slots of another storage, and destroy moved-from elements. No allocation is done. */
+		CONTAINER_TAPE_CONSTEXPR void _internal_move(pointer dst, pointer src_begin, pointer src_end)
+		{
+			_internal_move(dst, src_begin, (size_type)(src_end - src_begin));
 		}
 
 		/** Reallocate content in new memory with specified extra slots. */
-		void _reallocate(size_type before, size_type after)
+		CONTAINER_TAPE_CONSTEXPR void _reallocate(size_type before, size_type after)
 		{
 			size_type capa = before + after + _size;
 			
 			// Allocate new memory
 			pointer mem = capa>0 ? std::allocator_traits<allocator_type>::allocate(_alloc, capa, _base) : nullptr;
+			Stats::on_reallocate();
+			if(capa>0)
+				Stats::on_allocate(capa, capa * sizeof(value_type));
 			
 			// Move existing elements
 			_internal_move(mem+before, _start, _size);
@@ -1202,12 +2265,273 @@ namespace container
 			_start    = mem + before;
 			_capacity = capa;
 			// _size is unchanged			
+			_snapshot_slack();
+			_track_slack();
+		}
+
+		/** Update the front/back growth bias from the growth observed since last snapshot of slack.
+		 * Growth is the slack consumed on each side since last snapshot, plus free slots needed now.
+		 * The bias is an exponential moving average of the front share of growth.
+		 * The snapshot is packed in fractions of the capacity, so small growths of large tapes are approximated.
+		 * \param before Free slots needed before first element.
+		 * \param after Free slots needed after last element.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _learn_bias(size_type before, size_type after)
+		{
+			size_type front = before > capacity_before() ? before - capacity_before() : 0;
+			size_type back  = after > capacity_after() ? after - capacity_after() : 0;
+			size_type last_before = _unpack_slack(_bias >> _bias_share_bits);
+			size_type last_after  = _unpack_slack(_bias >> (_bias_share_bits + _bias_slack_bits));
+			if(last_before > capacity_before())
+				front += last_before - capacity_before();
+			if(last_after > capacity_after())
+				back += last_after - capacity_after();
+			if(front + back > 0)
+			{
+				std::uint32_t share = (std::uint32_t)(((double)front * (_bias_share + 1)) / (double)(front + back) + 0.5);
+				if(share > _bias_share)
+					share = _bias_share;
+				std::uint32_t last = _bias & _bias_share;
+				// Rounded toward the new share, so that a steady growth reaches it
+				_bias = (_bias & ~_bias_share) | ((last + share + (share > last ? 1 : 0)) / 2);
+			}
+		}
+
+		/** Remember current slack, as reference for next learning of bias. */
+		CONTAINER_TAPE_CONSTEXPR void _snapshot_slack()
+		{
+			_bias = (_bias & _bias_share) | (_pack_slack(capacity_before()) << _bias_share_bits)
+				| (_pack_slack(capacity_after()) << (_bias_share_bits + _bias_slack_bits));
+		}
+
+		/** Number of free slots to put before first element when distributing slack according to learned bias. */
+		CONTAINER_TAPE_CONSTEXPR size_type _front_slack(size_type slack) const
+		{
+			size_type front = (size_type)((double)slack * (_bias & _bias_share) / (_bias_share + 1));
+			return front < slack ? front : slack;
+		}
+
+		/** Packs a number of free slots as a fraction of the capacity, for the growth bias. */
+		CONTAINER_TAPE_CONSTEXPR std::uint32_t _pack_slack(size_type n) const
+		{
+			return _capacity ? (std::uint32_t)(((double)n * _bias_slack_one) / (double)_capacity + 0.5) : 0;
+		}
+
+		/** Unpacks a number of free slots packed by _pack_slack(). */
+		CONTAINER_TAPE_CONSTEXPR size_type _unpack_slack(std::uint32_t packed) const
+		{
+			return (size_type)(((double)(packed & _bias_slack_one) * (double)_capacity) / _bias_slack_one + 0.5);
+		}
+
+		/** Compute the slack of a reallocation making room for new elements.
+		 * New slack is proportional to size, so the number of reallocations is logarithmic,
+		 * and is split before and after elements according to learned growth bias.
+		 * \param before Minimal free slots needed before first element.
+		 * \param after Minimal free slots needed after last element.
+		 * \param front,back Free slots to put before and after elements.
+		 */
+		CONTAINER_TAPE_CONSTEXPR void _growth_slack(size_type before, size_type after, size_type& front, size_type& back)
+		{
+			_learn_bias(before, after);
+
+			size_type slack = _size > 64 ? _size : 64;
+			if(slack < before + after)
+				slack = before + after;
+
+			front = _front_slack(slack);
+			back  = slack - front;
+			if(front < before)
+			{
+				front = before;
+				back  = slack - front;
+			}
+			else if(back < after)
+			{
+				back  = after;
+				front = slack - back;
+			}
+		}
+
+		/** Reallocate to make room for new elements.
+		 * \param before Minimal free slots needed before first element.
+		 * \param after Minimal free slots needed after last element.
+		 * \see _growth_slack
+		 * Kept out of line, so that the fast paths of insertions calling it are small enough to be inlined.
+		 */
+		CONTAINER_TAPE_NOINLINE CONTAINER_TAPE_CONSTEXPR void _grow(size_type before, size_type after)
+		{
+			if(_shrink().slides() && _slide(before, after))
+				return;
+			size_type front, back;
+			_growth_slack(before, after, front, back);
+			_reallocate(front, back);
+		}
+
+		/** Make room on one side by sliding elements over the free slots of the other side, if they exceed the sliding threshold of the shrink policy.
+		 * Free slots are then split according to the learned growth bias.
+		 * \param before Minimal free slots needed before first element.
+		 * \param after Minimal free slots needed after last element.
+		 * \return true if elements have been slid, false if room has to be made by reallocation.
+		 */
+		CONTAINER_TAPE_CONSTEXPR bool _slide(size_type before, size_type after)
+		{
+			if(before > 0 && after > 0)
+				return false;
+			size_type opposite = after > 0 ? capacity_before() : capacity_after();
+			if(opposite < before + after || opposite < _capacity * _shrink().slide_above)
+				return false;
+
+			_learn_bias(before, after);
+			size_type slack = _capacity - _size - before - after;
+			size_type front = before + _front_slack(slack);
+			pointer start = _base + front;
+			if(start < _start)
+				_move_left(start, _start, _start + _size);
+			else if(start > _start)
+				_move_right(_start, _start + _size, start + _size);
+			_start = start;
+			_snapshot_slack();
+			_track_slack();
+			return true;
+		}
+
+		/** Undoes the front part of an in-slack batch insertion stopped at insertion i, it:
+		 * blocks shifted for insertions 0 to i are moved back, from the last, then front slack constructed up to built is destroyed.
+		 */
+		template <class BidirectionalIterator>
+		CONTAINER_TAPE_CONSTEXPR void _undo_batch_front(BidirectionalIterator it, size_type i, size_type m, pointer old_start, pointer built)
+		{
+			for(size_type b = i + 1; b-- > 0; )
+			{
+				size_type hi = (*it).first;
+				size_type lo = b > 0 ? (size_type)(*--it).first : 0;
+				std::move_backward(old_start + lo - (m - b), old_start + hi - (m - b), old_start + hi);
+			}
+			_destroy_n(old_start - m, std::min(built, old_start) - (old_start - m));
+		}
+
+		/** Undoes the back part of an in-slack batch insertion stopped at insertion i, it:
+		 * blocks shifted for insertions i to k-1 are moved back, from the first, then back slack constructed from built is destroyed.
+		 */
+		template <class BidirectionalIterator>
+		CONTAINER_TAPE_CONSTEXPR void _undo_batch_back(BidirectionalIterator it, BidirectionalIterator last, size_type i, size_type k, size_type m, pointer old_start, pointer built)
+		{
+			pointer old_end = old_start + _size;
+			for(size_type b = i; b < k; ++b)
+			{
+				size_type lo = (*it).first;
+				size_type hi = ++it != last ? (size_type)(*it).first : _size;
+				std::move(old_start + lo + (b + 1 - m), old_start + hi + (b + 1 - m), old_start + lo);
+			}
+			built = std::max(built, old_end);
+			_destroy_n(built, old_end + (k - m) - built);
+		}
+
+		/** Reallocate with room for the k elements of a batch insertion, constructed directly at their final place among the moved elements.
+		 * New elements are constructed first: if one throws, the tape is left unchanged.
+		 */
+		template <class BidirectionalIterator>
+		CONTAINER_TAPE_NOINLINE CONTAINER_TAPE_CONSTEXPR void _insert_batch_reallocate(BidirectionalIterator first, BidirectionalIterator last, size_type k)
+		{
+			size_type front, back;
+			_growth_slack(0, 0, front, back);
+			size_type capa = front + _size + k + back;
+			pointer mem = std::allocator_traits<allocator_type>::allocate(_alloc, capa, _base);
+			pointer start = mem + front;
+
+			size_type j = 0;
+			try
+			{
+				for(BidirectionalIterator it = first; it != last; ++it, ++j)
+					_construct(start + (*it).first + j, (*it).second);
+			}
+			catch(...)
+			{
+				size_type i = 0;
+				for(BidirectionalIterator it = first; i < j; ++it, ++i)
+					_destroy(start + (*it).first + i);
+				std::allocator_traits<allocator_type>::deallocate(_alloc, mem, capa);
+				throw;
+			}
+			Stats::on_reallocate();
+			Stats::on_allocate(capa, capa * sizeof(value_type));
+
+			// Move existing elements around new ones
+			pointer src = _start, dst = start;
+			for(BidirectionalIterator it = first; it != last; ++it)
+			{
+				pointer stop = _start + (*it).first;
+				_internal_move(dst, src, stop);
+				dst += stop - src + 1;
+				src = stop;
+			}
+			_internal_move(dst, src, _start + _size);
+
+			if(_base)
+				std::allocator_traits<allocator_type>::deallocate(_alloc, _base, _capacity);
+			_base     = mem;
+			_start    = start;
+			_capacity = capa;
+			_size    += k;
+			_snapshot_slack();
+			_track_slack();
 		}
 
 	};
 
-	template <class T, class Allocator>
-	inline void swap(tape<T, Allocator>& x, tape<T, Allocator>& y)
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR void swap(tape<T, Allocator, Stats, Shrink>& x, tape<T, Allocator, Stats, Shrink>& y)
 	{  x.swap(y);  }
+
+	/** Tells if two tapes have the same size and equal elements at each position. */
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR bool operator==(const tape<T, Allocator, Stats, Shrink>& x, const tape<T, Allocator, Stats, Shrink>& y)
+	{  return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());  }
+
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR bool operator!=(const tape<T, Allocator, Stats, Shrink>& x, const tape<T, Allocator, Stats, Shrink>& y)
+	{  return !(x == y);  }
+
+	/** Compares the elements of two tapes lexicographically. */
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR bool operator<(const tape<T, Allocator, Stats, Shrink>& x, const tape<T, Allocator, Stats, Shrink>& y)
+	{  return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());  }
+
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR bool operator>(const tape<T, Allocator, Stats, Shrink>& x, const tape<T, Allocator, Stats, Shrink>& y)
+	{  return y < x;  }
+
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR bool operator<=(const tape<T, Allocator, Stats, Shrink>& x, const tape<T, Allocator, Stats, Shrink>& y)
+	{  return !(y < x);  }
+
+	template <class T, class Allocator, class Stats, class Shrink>
+	inline CONTAINER_TAPE_CONSTEXPR bool operator>=(const tape<T, Allocator, Stats, Shrink>& x, const tape<T, Allocator, Stats, Shrink>& y)
+	{  return !(x < y);  }
+
+	/** Removes all elements of the tape for which pred returns true, in a single pass.
+	 * \see tape::remove_if
+	 */
+	template <class T, class Allocator, class Stats, class Shrink, class Predicate>
+	inline CONTAINER_TAPE_CONSTEXPR typename tape<T, Allocator, Stats, Shrink>::size_type erase_if(tape<T, Allocator, Stats, Shrink>& t, Predicate pred)
+	{  return t.remove_if(pred);  }
+
+	/** Removes the elements of the tape at the positions of the sorted range [first, last), in a single pass.
+	 * \see tape::erase_indices
+	 */
+	template <class T, class Allocator, class Stats, class Shrink, class BidirectionalIterator>
+	inline CONTAINER_TAPE_CONSTEXPR typename tape<T, Allocator, Stats, Shrink>::size_type erase_indices(tape<T, Allocator, Stats, Shrink>& t, BidirectionalIterator first, BidirectionalIterator last)
+	{  return t.erase_indices(first, last);  }
+
+#ifdef CONTAINER_TAPE_HAS_PMR
+	namespace pmr
+	{
+		/** Tape using polymorphic allocator, its memory comes from the std::pmr::memory_resource given at construction. */
+		template <typename T, typename Stats = tape_no_stats, typename Shrink = tape_no_shrink>
+		using tape = container::tape<T, std::pmr::polymorphic_allocator<T>, Stats, Shrink>;
+	} // namespace pmr
+#endif
 	
 } // namespace container
+
+#endif // CPPCONTAINERS_TAPE_HPP
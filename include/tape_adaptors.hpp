@@ -0,0 +1,41 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_TAPE_ADAPTORS_HPP
+#define CPPCONTAINERS_TAPE_ADAPTORS_HPP
+
+#include "tape.hpp"
+
+#include <functional>
+#include <queue>
+#include <stack>
+
+
+namespace container
+{
+
+	/**
+	 * FIFO queue, the standard adaptor over a tape.
+	 * Elements are stored contiguously and popping only advances the tape start.
+	 * A queue keeping a steady window of elements stops allocating when built from a tape whose shrink policy parameter
+	 * is tape_shrink_policy, set to tape_shrink_policy::sliding_window(), which is kept when the tape is moved into the queue.
+	 */
+	template <typename T, typename Container = tape<T> >
+	using queue = std::queue<T, Container>;
+
+	/** LIFO stack, the standard adaptor over a tape. */
+	template <typename T, typename Container = tape<T> >
+	using stack = std::stack<T, Container>;
+
+	/** Priority queue, the standard adaptor keeping a heap in a tape. */
+	template <typename T, typename Container = tape<T>, typename Compare = std::less<typename Container::value_type> >
+	using priority_queue = std::priority_queue<T, Container, Compare>;
+
+} // namespace container
+
+#endif // CPPCONTAINERS_TAPE_ADAPTORS_HPP
@@ -0,0 +1,411 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_TAPE_SPAN_HPP
+#define CPPCONTAINERS_TAPE_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define CONTAINER_TAPE_HAS_STD_SPAN 1
+#endif
+#endif
+
+
+namespace container
+{
+
+	template <typename T> class strided_span;
+
+	/**
+	 * Tape span is a non-owning view of contiguous elements, like std::span with dynamic extent, available since C++11.
+	 *
+	 * It is returned by tape::slice() to pass sub-ranges of tapes without copying them.
+	 * Like any view, it is invalidated when the viewed elements are moved, by a reallocation of the tape for example.
+	 * Views of sub-ranges (first(), last(), subspan()) and strided views (stride()) are built in constant time.
+	 * When std::span is available, tape spans are implicitly convertible to it.
+	 *
+	 * \tparam T Type of the elements, const-qualified for read-only views. Aliased as member type tape_span::element_type.
+	 */
+	template <typename T>
+	class tape_span
+	{
+	public:
+		typedef T											element_type;		//!< The type of the viewed elements. The template parameter (T).
+		typedef typename std::remove_cv<T>::type			value_type;			//!< The type of the viewed elements, without cv-qualifiers.
+		typedef std::size_t									size_type;			//!< Unsigned integral type.
+		typedef std::ptrdiff_t								difference_type;	//!< Signed integral type.
+		typedef T*											pointer;			//!< Pointer to an element.
+		typedef const T*									const_pointer;		//!< Const pointer to an element.
+		typedef T&											reference;			//!< Reference to an element.
+		typedef const T&									const_reference;	//!< Const reference to an element.
+		typedef T*											iterator;			//!< Random access iterator to elements.
+		typedef std::reverse_iterator<iterator>				reverse_iterator;	//!< Reverse iterator to elements.
+
+		/** Special value of count, meaning "until the end of the span". */
+		static const size_type npos = (size_type)-1;
+
+	protected:
+		pointer   _data;
+		size_type _size;
+
+	public:
+		/** Constructs an empty span. */
+		tape_span() noexcept:_data(nullptr), _size(0) {}
+
+		/** Constructs a span of the count elements starting at data. */
+		tape_span(pointer data, size_type count) noexcept:_data(data), _size(count) {}
+
+		/** Constructs a span of the elements of [first, last). */
+		tape_span(pointer first, pointer last) noexcept:_data(first), _size(last - first) {}
+
+		/** Constructs a span of the elements of an array. */
+		template <std::size_t N>
+		tape_span(element_type (&arr)[N]) noexcept:_data(arr), _size(N) {}
+
+		/** Constructs a span from a span of compatible elements, typically a span of const elements from a span of mutable ones. */
+		template <typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		tape_span(const tape_span<U>& other) noexcept:_data(other.data()), _size(other.size()) {}
+
+#ifdef CONTAINER_TAPE_HAS_STD_SPAN
+		/** Converts to a std::span. */
+		operator std::span<T>() const noexcept {return std::span<T>(_data, _size);}
+#endif
+
+		/**
+		 * \name Element access
+		 * @{
+		 */
+
+		pointer data() const noexcept {return _data;}
+
+		reference operator[](size_type idx) const {return _data[idx];}
+
+		/** Returns the element at position idx, checking bounds.
+		 * \throw std::out_of_range if idx is not less than size().
+		 */
+		reference at(size_type idx) const
+		{
+			if(idx >= _size)
+				throw std::out_of_range("tape_span::at");
+			return _data[idx];
+		}
+
+		reference front() const {return _data[0];}
+		reference back() const {return _data[_size - 1];}
+
+		/** @} */
+
+		/**
+		 * \name Iterators
+		 * @{
+		 */
+
+		iterator begin() const noexcept {return _data;}
+		iterator end() const noexcept {return _data + _size;}
+		reverse_iterator rbegin() const noexcept {return reverse_iterator(end());}
+		reverse_iterator rend() const noexcept {return reverse_iterator(begin());}
+
+		/** @} */
+
+		/**
+		 * \name Observers
+		 * @{
+		 */
+
+		size_type size() const noexcept {return _size;}
+		size_type size_bytes() const noexcept {return _size * sizeof(element_type);}
+		bool empty() const noexcept {return _size == 0;}
+
+		/** @} */
+
+		/**
+		 * \name Subviews
+		 * @{
+		 */
+
+		/** Returns a view of the first count elements.
+		 * \throw std::out_of_range if count is greater than size().
+		 */
+		tape_span first(size_type count) const
+		{
+			_check(count, _size);
+			return tape_span(_data, count);
+		}
+
+		/** Returns a view of the last count elements.
+		 * \throw std::out_of_range if count is greater than size().
+		 */
+		tape_span last(size_type count) const
+		{
+			_check(count, _size);
+			return tape_span(_data + (_size - count), count);
+		}
+
+		/** Returns a view of the count elements from offset, or of all elements from offset if count is npos.
+		 * \throw std::out_of_range if offset or offset + count is greater than size().
+		 */
+		tape_span subspan(size_type offset, size_type count = npos) const
+		{
+			_check(offset, _size);
+			if(count == npos)
+				count = _size - offset;
+			_check(count, _size - offset);
+			return tape_span(_data + offset, count);
+		}
+
+		/** Returns a view of one element every step elements, starting with the first one.
+		 * \throw std::out_of_range if step is 0.
+		 */
+		strided_span<T> stride(size_type step) const
+		{
+			return strided_span<T>(_data, _size, 1).stride(step);
+		}
+
+		/** @} */
+
+	protected:
+		static void _check(size_type n, size_type max)
+		{
+			if(n > max)
+				throw std::out_of_range("tape_span");
+		}
+	};
+
+	template <typename T>
+	const typename tape_span<T>::size_type tape_span<T>::npos;
+
+
+	/**
+	 * Strided span iterator.
+	 * It holds the first element of its span and an index, so that iterating never computes addresses past the underlying storage.
+	 * Only iterators of the same span can be compared.
+	 */
+	template <typename T>
+	class strided_iterator
+	{
+	public:
+		typedef strided_iterator						self;
+		typedef std::random_access_iterator_tag			iterator_category;
+		typedef typename std::remove_cv<T>::type		value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef T*										pointer;
+		typedef T&										reference;
+
+	protected:
+		pointer _data;
+		difference_type _index;
+		difference_type _stride;
+
+	public:
+		strided_iterator():_data(nullptr), _index(0), _stride(1){}
+		strided_iterator(pointer data, difference_type index, difference_type stride):_data(data), _index(index), _stride(stride){}
+
+		reference  operator*() const {return _data[_index * _stride];}
+		pointer    operator->() const {return _data + _index * _stride;}
+		reference  operator[](difference_type off) const {return _data[(_index + off) * _stride];}
+
+		self& operator++() {++_index; return *this;}
+		self  operator++(int) {self tmp = *this; ++*this; return tmp;}
+		self& operator--() {--_index; return *this;}
+		self  operator--(int) {self tmp = *this; --*this; return tmp;}
+
+		self& operator+=(difference_type off) {_index += off; return *this;}
+		self  operator+(difference_type off)const {return self(_data, _index + off, _stride);}
+		friend self operator+(difference_type off, const self& right) {return right + off;}
+		self& operator-=(difference_type off) {_index -= off; return *this;}
+		self  operator-(difference_type off)const {return self(_data, _index - off, _stride);}
+		difference_type operator-(const self& right)const {return _index - right._index;}
+
+		bool operator==(const self& r)const{return _index==r._index;}
+		bool operator!=(const self& r)const{return _index!=r._index;}
+		bool operator<(const self& r)const{return _index<r._index;}
+		bool operator<=(const self& r)const{return _index<=r._index;}
+		bool operator>(const self& r)const{return _index>r._index;}
+		bool operator>=(const self& r)const{return _index>=r._index;}
+	};
+
+
+	/**
+	 * Strided span is a non-owning view of elements regularly spaced in contiguous storage,
+	 * like a column of a row-major matrix, or one channel of interleaved samples.
+	 *
+	 * Views of sub-ranges (first(), last(), subspan()) and of one element every n (stride()) are built in constant time.
+	 *
+	 * \tparam T Type of the elements, const-qualified for read-only views. Aliased as member type strided_span::element_type.
+	 */
+	template <typename T>
+	class strided_span
+	{
+	public:
+		typedef T											element_type;		//!< The type of the viewed elements. The template parameter (T).
+		typedef typename std::remove_cv<T>::type			value_type;			//!< The type of the viewed elements, without cv-qualifiers.
+		typedef std::size_t									size_type;			//!< Unsigned integral type.
+		typedef std::ptrdiff_t								difference_type;	//!< Signed integral type.
+		typedef T*											pointer;			//!< Pointer to an element.
+		typedef T&											reference;			//!< Reference to an element.
+		typedef strided_iterator<T>							iterator;			//!< Random access iterator to elements.
+		typedef std::reverse_iterator<iterator>				reverse_iterator;	//!< Reverse iterator to elements.
+
+		/** Special value of count, meaning "until the end of the span". */
+		static const size_type npos = (size_type)-1;
+
+	protected:
+		pointer   _data;
+		size_type _size;
+		size_type _stride;
+
+	public:
+		/** Constructs an empty span. */
+		strided_span() noexcept:_data(nullptr), _size(0), _stride(1) {}
+
+		/** Constructs a span of count elements, the first one at data, each one stride elements after the previous one.
+		 * \throw std::out_of_range if stride is 0.
+		 */
+		strided_span(pointer data, size_type count, size_type stride):
+		_data(data), _size(count), _stride(stride)
+		{
+			if(stride == 0)
+				throw std::out_of_range("strided_span");
+		}
+
+		/** Constructs a span from a span of compatible elements, typically a span of const elements from a span of mutable ones. */
+		template <typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		strided_span(const strided_span<U>& other) noexcept:_data(other.data()), _size(other.size()), _stride(other.get_stride()) {}
+
+		/** Constructs a span of all elements of a contiguous span. */
+		template <typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+		strided_span(const tape_span<U>& other) noexcept:_data(other.data()), _size(other.size()), _stride(1) {}
+
+		/**
+		 * \name Element access
+		 * @{
+		 */
+
+		/** Returns a pointer to the first element. */
+		pointer data() const noexcept {return _data;}
+
+		reference operator[](size_type idx) const {return _data[idx * _stride];}
+
+		/** Returns the element at position idx, checking bounds.
+		 * \throw std::out_of_range if idx is not less than size().
+		 */
+		reference at(size_type idx) const
+		{
+			if(idx >= _size)
+				throw std::out_of_range("strided_span::at");
+			return _data[idx * _stride];
+		}
+
+		reference front() const {return _data[0];}
+		reference back() const {return _data[(_size - 1) * _stride];}
+
+		/** @} */
+
+		/**
+		 * \name Iterators
+		 * @{
+		 */
+
+		iterator begin() const noexcept {return iterator(_data, 0, _stride);}
+		iterator end() const noexcept {return iterator(_data, _size, _stride);}
+		reverse_iterator rbegin() const noexcept {return reverse_iterator(end());}
+		reverse_iterator rend() const noexcept {return reverse_iterator(begin());}
+
+		/** @} */
+
+		/**
+		 * \name Observers
+		 * @{
+		 */
+
+		size_type size() const noexcept {return _size;}
+		bool empty() const noexcept {return _size == 0;}
+
+		/** Returns the distance between two consecutive elements, in elements of the underlying storage. */
+		size_type get_stride() const noexcept {return _stride;}
+
+		/** Tells if the elements are contiguous. */
+		bool is_contiguous() const noexcept {return _stride == 1 || _size <= 1;}
+
+		/** @} */
+
+		/**
+		 * \name Subviews
+		 * @{
+		 */
+
+		/** Returns a view of the first count elements.
+		 * \throw std::out_of_range if count is greater than size().
+		 */
+		strided_span first(size_type count) const
+		{
+			_check(count, _size);
+			return strided_span(_data, count, _stride);
+		}
+
+		/** Returns a view of the last count elements.
+		 * \throw std::out_of_range if count is greater than size().
+		 */
+		strided_span last(size_type count) const
+		{
+			_check(count, _size);
+			return strided_span(_address(_size - count), count, _stride);
+		}
+
+		/** Returns a view of the count elements from offset, or of all elements from offset if count is npos.
+		 * \throw std::out_of_range if offset or offset + count is greater than size().
+		 */
+		strided_span subspan(size_type offset, size_type count = npos) const
+		{
+			_check(offset, _size);
+			if(count == npos)
+				count = _size - offset;
+			_check(count, _size - offset);
+			return strided_span(_address(offset), count, _stride);
+		}
+
+		/** Returns a view of one element every step elements, starting with the first one.
+		 * \throw std::out_of_range if step is 0, or if the resulting stride overflows size_type.
+		 */
+		strided_span stride(size_type step) const
+		{
+			if(step == 0 || step > (size_type)-1 / _stride)
+				throw std::out_of_range("strided_span::stride");
+			return strided_span(_data, _size ? (_size - 1) / step + 1 : 0, _stride * step);
+		}
+
+		/** @} */
+
+	protected:
+		static void _check(size_type n, size_type max)
+		{
+			if(n > max)
+				throw std::out_of_range("strided_span");
+		}
+
+		/** Returns the address of the element idx, or the address following the last element if idx is size().
+		 * The underlying storage may end right after the last element, so the stride is not added past it.
+		 */
+		pointer _address(size_type idx) const
+		{
+			return idx < _size ? _data + idx * _stride : _data + (_size ? (_size - 1) * _stride + 1 : 0);
+		}
+	};
+
+	template <typename T>
+	const typename strided_span<T>::size_type strided_span<T>::npos;
+
+} // namespace container
+
+#endif // CPPCONTAINERS_TAPE_SPAN_HPP
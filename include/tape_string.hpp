@@ -0,0 +1,681 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_TAPE_STRING_HPP
+#define CPPCONTAINERS_TAPE_STRING_HPP
+
+#include "tape.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+
+namespace container
+{
+
+	/**
+	 * Tape string is a string which can grow at both ends in amortized constant time.
+	 *
+	 * It is made for building messages whose headers are known after their payload:
+	 * the payload is appended, then headers and length fields are prepended, without copying the payload.
+	 *
+	 * Short strings are stored in the string object itself (small string optimization).
+	 * Longer ones are stored in a tape, with free slots before and after the characters.
+	 * In both cases the characters are followed by a null character, so c_str() is data().
+	 *
+	 * The interface follows std::basic_string, plus prepend(), push_front() and pop_front().
+	 *
+	 * \tparam CharT Type of the characters. Aliased as member type basic_tape_string::value_type.
+	 * \tparam Traits Character traits. Aliased as member type basic_tape_string::traits_type.
+	 * \tparam Allocator Type of the allocator of the tape storing long strings. Aliased as member type basic_tape_string::allocator_type.
+	 */
+	template <typename CharT, typename Traits = std::char_traits<CharT>, typename Allocator = std::allocator<CharT> >
+	class basic_tape_string
+	{
+	public:
+		typedef Traits										traits_type;		//!< Character traits. The second template parameter (Traits).
+		typedef CharT										value_type;			//!< The type of characters. The first template parameter (CharT).
+		typedef Allocator									allocator_type;		//!< The type of allocator of long strings storage. The third template parameter (Allocator).
+		typedef tape<CharT, Allocator>						tape_type;			//!< The type of tape storing long strings.
+		typedef typename tape_type::size_type				size_type;			//!< Unsigned integral type, usually same as size_t.
+		typedef typename tape_type::difference_type			difference_type;	//!< Signed integral type, usually same as ptrdiff_t.
+		typedef value_type&									reference;			//!< Reference to a character.
+		typedef const value_type&							const_reference;	//!< Const reference to a character.
+		typedef value_type*									pointer;			//!< Pointer to a character.
+		typedef const value_type*							const_pointer;		//!< Const pointer to a character.
+		typedef value_type*									iterator;			//!< Random access iterator to characters.
+		typedef const value_type*							const_iterator;		//!< Random access iterator to const characters.
+		typedef std::reverse_iterator<iterator>				reverse_iterator;	//!< Reverse iterator to characters.
+		typedef std::reverse_iterator<const_iterator>		const_reverse_iterator;	//!< Reverse iterator to const characters.
+
+		/** Maximal number of characters stored in the string object itself. */
+		static const size_type small_capacity = 16 / sizeof(CharT) - 1;
+
+		/** Special value, meaning "until the end of the string" as a length, or "not found" as a position. */
+		static const size_type npos = (size_type)-1;
+
+	protected:
+		/** Storage of long strings, its last element is the null character. Empty for short strings. */
+		tape_type _tape;
+		/** Storage of short strings, followed by the null character. */
+		value_type _small[small_capacity + 1];
+		/** Length of short strings. */
+		size_type _small_size;
+
+	public:
+		/**
+		 * \name Construction and assignment
+		 * @{
+		 */
+
+		/** Constructs an empty string. */
+		basic_tape_string():
+		_small_size(0)
+		{
+			_small[0] = value_type();
+		}
+
+		/** Constructs an empty string, with the given allocator for long strings. */
+		explicit basic_tape_string(const allocator_type& alloc):
+		_tape(alloc),
+		_small_size(0)
+		{
+			_small[0] = value_type();
+		}
+
+		/** Constructs a string copying the null-terminated character string s. */
+		basic_tape_string(const value_type* s):
+		basic_tape_string()
+		{
+			append(s);
+		}
+
+		/** Constructs a string copying the n first characters of s. */
+		basic_tape_string(const value_type* s, size_type n):
+		basic_tape_string()
+		{
+			append(s, n);
+		}
+
+		/** Constructs a string of n copies of character c. */
+		basic_tape_string(size_type n, value_type c):
+		basic_tape_string()
+		{
+			append(n, c);
+		}
+
+		/** Constructs a string copying the characters of a standard string. */
+		template<class StrAlloc>
+		explicit basic_tape_string(const std::basic_string<CharT, Traits, StrAlloc>& str):
+		basic_tape_string()
+		{
+			append(str.data(), str.size());
+		}
+
+#if __cplusplus >= 201703L
+		/** Constructs a string copying the characters of a string view. */
+		explicit basic_tape_string(std::basic_string_view<CharT, Traits> sv):
+		basic_tape_string()
+		{
+			append(sv.data(), sv.size());
+		}
+#endif
+
+		/** Copy constructor. */
+		basic_tape_string(const basic_tape_string& str):
+		_tape(std::allocator_traits<allocator_type>::select_on_container_copy_construction(str._tape.get_allocator())),
+		_small_size(0)
+		{
+			_small[0] = value_type();
+			append(str.data(), str.size());
+		}
+
+		/** Move constructor. Long strings are taken over, the moved string is left empty. */
+		basic_tape_string(basic_tape_string&& str) noexcept:
+		_tape(std::move(str._tape)),
+		_small_size(str._small_size)
+		{
+			traits_type::copy(_small, str._small, _small_size + 1);
+			str._small_size = 0;
+			str._small[0] = value_type();
+		}
+
+		basic_tape_string& operator=(const basic_tape_string& str)
+		{
+			if(this != &str)
+				assign(str.data(), str.size());
+			return *this;
+		}
+
+		basic_tape_string& operator=(basic_tape_string&& str)
+		{
+			if(this != &str)
+			{
+				_tape = std::move(str._tape);
+				_small_size = str._small_size;
+				traits_type::copy(_small, str._small, _small_size + 1);
+				str._tape.clear();
+				str._small_size = 0;
+				str._small[0] = value_type();
+			}
+			return *this;
+		}
+
+		basic_tape_string& operator=(const value_type* s) {return assign(s);}
+
+		basic_tape_string& operator=(value_type c) {return assign(1, c);}
+
+		/** Replaces the content by the n first characters of s. */
+		basic_tape_string& assign(const value_type* s, size_type n)
+		{
+			if(_aliases(s))
+				return assign(basic_tape_string(s, n));
+			clear();
+			return append(s, n);
+		}
+
+		/** Replaces the content by the null-terminated character string s. */
+		basic_tape_string& assign(const value_type* s) {return assign(s, traits_type::length(s));}
+
+		/** Replaces the content by n copies of character c. */
+		basic_tape_string& assign(size_type n, value_type c)
+		{
+			clear();
+			return append(n, c);
+		}
+
+		/** Replaces the content by a copy of str. */
+		basic_tape_string& assign(const basic_tape_string& str) {return *this = str;}
+
+		/** Replaces the content by str, moved. */
+		basic_tape_string& assign(basic_tape_string&& str) {return *this = std::move(str);}
+
+		/** Returns the allocator of long strings storage. */
+		allocator_type get_allocator() const {return _tape.get_allocator();}
+
+		/** @} */
+
+		/**
+		 * \name Element access
+		 * @{
+		 */
+
+		/** Returns a pointer to the characters, which are followed by a null character. */
+		const value_type* data() const noexcept {return _is_small() ? _small : _tape.data();}
+		value_type* data() noexcept {return _is_small() ? _small : _tape.data();}
+
+		/** Returns a pointer to the null-terminated characters. */
+		const value_type* c_str() const noexcept {return data();}
+
+		reference operator[](size_type pos) {return data()[pos];}
+		const_reference operator[](size_type pos) const {return data()[pos];}
+
+		/** Returns the character at position pos, checking bounds.
+		 * \throw std::out_of_range if pos is not less than size().
+		 */
+		reference at(size_type pos)
+		{
+			_check_pos(pos + 1);
+			return data()[pos];
+		}
+
+		const_reference at(size_type pos) const
+		{
+			_check_pos(pos + 1);
+			return data()[pos];
+		}
+
+		reference front() {return data()[0];}
+		const_reference front() const {return data()[0];}
+		reference back() {return data()[size() - 1];}
+		const_reference back() const {return data()[size() - 1];}
+
+#if __cplusplus >= 201703L
+		/** Returns a view of the characters. */
+		operator std::basic_string_view<CharT, Traits>() const noexcept
+		{
+			return std::basic_string_view<CharT, Traits>(data(), size());
+		}
+#endif
+
+		/** Returns a copy of the characters as standard string. */
+		std::basic_string<CharT, Traits> str() const
+		{
+			return std::basic_string<CharT, Traits>(data(), size());
+		}
+
+		/** @} */
+
+		/**
+		 * \name Iterators
+		 * @{
+		 */
+
+		iterator begin() noexcept {return data();}
+		const_iterator begin() const noexcept {return data();}
+		iterator end() noexcept {return data() + size();}
+		const_iterator end() const noexcept {return data() + size();}
+		const_iterator cbegin() const noexcept {return begin();}
+		const_iterator cend() const noexcept {return end();}
+		reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+		const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+		reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+		const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+		const_reverse_iterator crbegin() const noexcept {return rbegin();}
+		const_reverse_iterator crend() const noexcept {return rend();}
+
+		/** @} */
+
+		/**
+		 * \name Capacity
+		 * @{
+		 */
+
+		/** Returns the number of characters. */
+		size_type size() const noexcept {return _is_small() ? _small_size : _tape.size() - 1;}
+		size_type length() const noexcept {return size();}
+		bool empty() const noexcept {return size() == 0;}
+
+		/** Returns the number of characters the string can hold without allocation. */
+		size_type capacity() const noexcept {return _is_small() ? small_capacity : _tape.capacity() - 1;}
+
+		/** Returns the number of characters which can be prepended without allocation. */
+		size_type capacity_front() const noexcept {return _is_small() ? small_capacity - _small_size : _tape.capacity_before();}
+
+		/** Requests a capacity of at least n characters. */
+		void reserve(size_type n)
+		{
+			if(n > capacity())
+			{
+				if(_is_small())
+					_to_tape(0, n - size());
+				else
+					_tape.reserve_after(n - size());
+			}
+		}
+
+		/** Requests room to prepend at least n characters without allocation. */
+		void reserve_front(size_type n)
+		{
+			if(n > capacity_front())
+			{
+				if(_is_small())
+					_to_tape(n, 0);
+				else
+					_tape.reserve_before(n);
+			}
+		}
+
+		/** Requests to reduce the capacity to fit the size. Long strings which become short enough are moved back in the string object. */
+		void shrink_to_fit()
+		{
+			if(!_is_small() && size() <= small_capacity)
+			{
+				_small_size = size();
+				traits_type::copy(_small, data(), _small_size + 1);
+				_tape.clear();
+			}
+			_tape.shrink_to_fit();
+		}
+
+		/** @} */
+
+		/**
+		 * \name Modifiers
+		 * @{
+		 */
+
+		/** Removes all characters. The storage of long strings is kept for next use. */
+		void clear() noexcept
+		{
+			_tape.clear();
+			_small_size = 0;
+			_small[0] = value_type();
+		}
+
+		/** Appends the n first characters of s. */
+		basic_tape_string& append(const value_type* s, size_type n)
+		{
+			if(n == 0)
+				return *this;
+			if(_aliases(s))
+				return append(basic_tape_string(s, n));
+			if(_is_small() && _small_size + n <= small_capacity)
+			{
+				traits_type::copy(_small + _small_size, s, n);
+				_small_size += n;
+				_small[_small_size] = value_type();
+				return *this;
+			}
+			traits_type::copy(_grow_back(n), s, n);
+			return *this;
+		}
+
+		/** Appends the null-terminated character string s. */
+		basic_tape_string& append(const value_type* s) {return append(s, traits_type::length(s));}
+
+		/** Appends n copies of character c. */
+		basic_tape_string& append(size_type n, value_type c)
+		{
+			if(n == 0)
+				return *this;
+			if(_is_small() && _small_size + n <= small_capacity)
+			{
+				traits_type::assign(_small + _small_size, n, c);
+				_small_size += n;
+				_small[_small_size] = value_type();
+				return *this;
+			}
+			traits_type::assign(_grow_back(n), n, c);
+			return *this;
+		}
+
+		/** Appends the characters of str. */
+		basic_tape_string& append(const basic_tape_string& str) {return append(str.data(), str.size());}
+
+		/** Appends the characters of a standard string. */
+		template<class StrAlloc>
+		basic_tape_string& append(const std::basic_string<CharT, Traits, StrAlloc>& str) {return append(str.data(), str.size());}
+
+		basic_tape_string& operator+=(const basic_tape_string& str) {return append(str);}
+		basic_tape_string& operator+=(const value_type* s) {return append(s);}
+		basic_tape_string& operator+=(value_type c) {return append(1, c);}
+		template<class StrAlloc>
+		basic_tape_string& operator+=(const std::basic_string<CharT, Traits, StrAlloc>& str) {return append(str);}
+
+		/** Appends character c. */
+		void push_back(value_type c) {append(1, c);}
+
+		/** Removes the last character. */
+		void pop_back() {erase(size() - 1, 1);}
+
+		/** Prepends the n first characters of s, in amortized constant time in the string length. */
+		basic_tape_string& prepend(const value_type* s, size_type n)
+		{
+			if(n == 0)
+				return *this;
+			if(_aliases(s))
+				return prepend(basic_tape_string(s, n));
+			if(_is_small() && _small_size + n <= small_capacity)
+			{
+				traits_type::move(_small + n, _small, _small_size + 1);
+				traits_type::copy(_small, s, n);
+				_small_size += n;
+				return *this;
+			}
+			traits_type::copy(_grow_front(n), s, n);
+			return *this;
+		}
+
+		/** Prepends the null-terminated character string s. */
+		basic_tape_string& prepend(const value_type* s) {return prepend(s, traits_type::length(s));}
+
+		/** Prepends n copies of character c. */
+		basic_tape_string& prepend(size_type n, value_type c)
+		{
+			if(n == 0)
+				return *this;
+			if(_is_small() && _small_size + n <= small_capacity)
+			{
+				traits_type::move(_small + n, _small, _small_size + 1);
+				traits_type::assign(_small, n, c);
+				_small_size += n;
+				return *this;
+			}
+			traits_type::assign(_grow_front(n), n, c);
+			return *this;
+		}
+
+		/** Prepends the characters of str. */
+		basic_tape_string& prepend(const basic_tape_string& str) {return prepend(str.data(), str.size());}
+
+		/** Prepends the characters of a standard string. */
+		template<class StrAlloc>
+		basic_tape_string& prepend(const std::basic_string<CharT, Traits, StrAlloc>& str) {return prepend(str.data(), str.size());}
+
+		/** Prepends character c. */
+		void push_front(value_type c) {prepend(1, c);}
+
+		/** Removes the first character. */
+		void pop_front() {erase(0, 1);}
+
+		/** Inserts the n first characters of s before position pos.
+		 * \throw std::out_of_range if pos is greater than size().
+		 */
+		basic_tape_string& insert(size_type pos, const value_type* s, size_type n)
+		{
+			_check_pos(pos);
+			if(n == 0)
+				return *this;
+			if(_aliases(s))
+				return insert(pos, basic_tape_string(s, n));
+			if(_is_small() && _small_size + n <= small_capacity)
+			{
+				traits_type::move(_small + pos + n, _small + pos, _small_size - pos + 1);
+				traits_type::copy(_small + pos, s, n);
+				_small_size += n;
+				return *this;
+			}
+			if(_is_small())
+				_to_tape(0, n);
+			_tape.insert(_tape.begin() + pos, s, s + n);
+			return *this;
+		}
+
+		/** Inserts the null-terminated character string s before position pos. */
+		basic_tape_string& insert(size_type pos, const value_type* s) {return insert(pos, s, traits_type::length(s));}
+
+		/** Inserts the characters of str before position pos. */
+		basic_tape_string& insert(size_type pos, const basic_tape_string& str) {return insert(pos, str.data(), str.size());}
+
+		/** Removes n characters from position pos, or all characters after pos if there are fewer.
+		 * Characters of the shortest side are shifted.
+		 * \throw std::out_of_range if pos is greater than size().
+		 */
+		basic_tape_string& erase(size_type pos = 0, size_type n = npos)
+		{
+			_check_pos(pos);
+			if(n > size() - pos)
+				n = size() - pos;
+			if(n == 0)
+				return *this;
+			if(_is_small())
+			{
+				traits_type::move(_small + pos, _small + pos + n, _small_size - pos - n + 1);
+				_small_size -= n;
+			}
+			else
+				_tape.erase(_tape.begin() + pos, _tape.begin() + pos + n);
+			return *this;
+		}
+
+		/** Exchanges the content with another string. */
+		void swap(basic_tape_string& str)
+		{
+			_tape.swap(str._tape);
+			value_type small[small_capacity + 1];
+			traits_type::copy(small, _small, small_capacity + 1);
+			traits_type::copy(_small, str._small, small_capacity + 1);
+			traits_type::copy(str._small, small, small_capacity + 1);
+			std::swap(_small_size, str._small_size);
+		}
+
+		/** @} */
+
+		/**
+		 * \name Operations
+		 * @{
+		 */
+
+		/** Returns a string of the n characters from position pos, or of all characters after pos if there are fewer.
+		 * \throw std::out_of_range if pos is greater than size().
+		 */
+		basic_tape_string substr(size_type pos = 0, size_type n = npos) const
+		{
+			_check_pos(pos);
+			if(n > size() - pos)
+				n = size() - pos;
+			return basic_tape_string(data() + pos, n);
+		}
+
+		/** Compares with the n first characters of s, like std::basic_string::compare. */
+		int compare(const value_type* s, size_type n) const
+		{
+			size_type len = std::min(size(), n);
+			int res = traits_type::compare(data(), s, len);
+			if(res != 0)
+				return res;
+			return size() < n ? -1 : size() > n ? 1 : 0;
+		}
+
+		int compare(const basic_tape_string& str) const {return compare(str.data(), str.size());}
+		int compare(const value_type* s) const {return compare(s, traits_type::length(s));}
+
+		/** Returns the position of the first occurrence of the n first characters of s from position pos, or npos. */
+		size_type find(const value_type* s, size_type pos, size_type n) const
+		{
+			if(pos > size() || n > size() - pos)
+				return npos;
+			const_iterator it = std::search(begin() + pos, end(), s, s + n, traits_type::eq);
+			return it == end() && n > 0 ? npos : it - begin();
+		}
+
+		size_type find(const value_type* s, size_type pos = 0) const {return find(s, pos, traits_type::length(s));}
+		size_type find(const basic_tape_string& str, size_type pos = 0) const {return find(str.data(), pos, str.size());}
+
+		/** Returns the position of the first occurrence of character c from position pos, or npos. */
+		size_type find(value_type c, size_type pos = 0) const
+		{
+			if(pos >= size())
+				return npos;
+			const value_type* res = traits_type::find(data() + pos, size() - pos, c);
+			return res ? res - data() : npos;
+		}
+
+		/** @} */
+
+	protected:
+		/** Tell if the string is short, stored in the string object itself. */
+		bool _is_small() const noexcept {return _tape.empty();}
+
+		/** Tell if a pointer refers to the characters of the string. */
+		bool _aliases(const value_type* s) const
+		{
+			return !std::less<const value_type*>()(s, data()) && std::less<const value_type*>()(s, data() + size() + 1);
+		}
+
+		/** Check that pos is not greater than size(). */
+		void _check_pos(size_type pos) const
+		{
+			if(pos > size())
+				throw std::out_of_range("tape_string");
+		}
+
+		/** Move a short string into the tape, with room for before and after characters.
+		 * Storage kept by a previous clear() is reused when big enough.
+		 * Otherwise a quarter of the needed room is added on both sides, so a string which has just been filled
+		 * can get headers prepended or a trailer appended without reallocation.
+		 */
+		void _to_tape(size_type before, size_type after)
+		{
+			size_type n = _small_size + 1;
+			size_type extra = (before + n + after) / 4;
+			if(_tape.capacity() >= before + n + after)
+				_tape.recenter(before + (_tape.capacity() - before - n - after) / 2);
+			else
+				_tape.reserve(before + extra, n + after + extra);
+			traits_type::copy(_tape.grow_back_uninitialized(n), _small, n);
+			_tape.commit_back(n);
+		}
+
+		/** Make room for n characters after the last one, and adopt them.
+		 * \return Pointer to the first of the n characters, to be written.
+		 */
+		value_type* _grow_back(size_type n)
+		{
+			if(_is_small())
+				_to_tape(0, n);
+			// The null character slot becomes the first new character.
+			value_type* res = _tape.grow_back_uninitialized(n) - 1;
+			_tape.commit_back(n);
+			res[n] = value_type();
+			return res;
+		}
+
+		/** Make room for n characters before the first one, and adopt them.
+		 * \return Pointer to the first of the n characters, to be written.
+		 */
+		value_type* _grow_front(size_type n)
+		{
+			if(_is_small())
+				_to_tape(n, 0);
+			value_type* res = _tape.grow_front_uninitialized(n);
+			_tape.commit_front(n);
+			return res;
+		}
+	};
+
+	template <typename CharT, typename Traits, typename Allocator>
+	const typename basic_tape_string<CharT, Traits, Allocator>::size_type basic_tape_string<CharT, Traits, Allocator>::small_capacity;
+
+	template <typename CharT, typename Traits, typename Allocator>
+	const typename basic_tape_string<CharT, Traits, Allocator>::size_type basic_tape_string<CharT, Traits, Allocator>::npos;
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator==(const basic_tape_string<CharT, Traits, Allocator>& x, const basic_tape_string<CharT, Traits, Allocator>& y)
+	{  return x.compare(y) == 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator!=(const basic_tape_string<CharT, Traits, Allocator>& x, const basic_tape_string<CharT, Traits, Allocator>& y)
+	{  return x.compare(y) != 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator<(const basic_tape_string<CharT, Traits, Allocator>& x, const basic_tape_string<CharT, Traits, Allocator>& y)
+	{  return x.compare(y) < 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator<=(const basic_tape_string<CharT, Traits, Allocator>& x, const basic_tape_string<CharT, Traits, Allocator>& y)
+	{  return x.compare(y) <= 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator>(const basic_tape_string<CharT, Traits, Allocator>& x, const basic_tape_string<CharT, Traits, Allocator>& y)
+	{  return x.compare(y) > 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator>=(const basic_tape_string<CharT, Traits, Allocator>& x, const basic_tape_string<CharT, Traits, Allocator>& y)
+	{  return x.compare(y) >= 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator==(const basic_tape_string<CharT, Traits, Allocator>& x, const CharT* s)
+	{  return x.compare(s) == 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline bool operator!=(const basic_tape_string<CharT, Traits, Allocator>& x, const CharT* s)
+	{  return x.compare(s) != 0;  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const basic_tape_string<CharT, Traits, Allocator>& str)
+	{  return os.write(str.data(), str.size());  }
+
+	template <typename CharT, typename Traits, typename Allocator>
+	inline void swap(basic_tape_string<CharT, Traits, Allocator>& x, basic_tape_string<CharT, Traits, Allocator>& y)
+	{  x.swap(y);  }
+
+	typedef basic_tape_string<char>		tape_string;	//!< Tape string of char.
+	typedef basic_tape_string<wchar_t>	wtape_string;	//!< Tape string of wchar_t.
+
+} // namespace container
+
+#endif // CPPCONTAINERS_TAPE_STRING_HPP
@@ -0,0 +1,147 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "append_only_tape.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "Append only tape append", "[tape]" ) {
+	container::append_only_tape<std::string> tape;
+	CHECK( tape.size() == 0 );
+	CHECK( tape.published() == 0 );
+	CHECK_FALSE( tape.ready(0) );
+
+	CHECK( tape.push_back("first") == 0 );
+	const std::string* first = &tape[0];
+	for(int n = 1; n < 10000; ++n)
+		CHECK( tape.emplace_back(std::to_string(n)) == (std::size_t)n );
+
+	CHECK( tape.size() == 10000 );
+	CHECK( tape.published() == 10000 );
+	CHECK( tape.published(9000) == 10000 );
+	CHECK( tape.ready(9999) );
+	CHECK_FALSE( tape.ready(10000) );
+	// Elements never move
+	CHECK( &tape[0] == first );
+	CHECK( tape[0] == "first" );
+	CHECK( tape[63] == "63" );
+	CHECK( tape[64] == "64" );
+	CHECK( tape[9999] == "9999" );
+}
+
+struct throwing_record
+{
+	int value;
+	explicit throwing_record(int v):value(v) {if(v < 0) throw std::runtime_error("record");}
+};
+
+TEST_CASE( "Append only tape skips failed constructions", "[tape]" ) {
+	container::append_only_tape<throwing_record> tape;
+	tape.emplace_back(1);
+	CHECK_THROWS_AS( tape.emplace_back(-1), std::runtime_error );
+	tape.emplace_back(3);
+	CHECK_THROWS_AS( tape.emplace_back(-1), std::runtime_error );
+
+	CHECK( tape.size() == 4 );
+	CHECK_FALSE( tape.failed(0) );
+	CHECK_FALSE( tape.ready(1) );
+	CHECK( tape.failed(1) );
+	CHECK( tape.ready(2) );
+	CHECK( tape[2].value == 3 );
+	CHECK( tape.failed(3) );
+	CHECK_FALSE( tape.failed(4) );
+
+	// Consumers go past failed elements to the following ones
+	CHECK( tape.published() == 4 );
+	int sum = 0;
+	for(std::size_t n = 0; n < tape.published(); ++n)
+		if(tape.ready(n))
+			sum += tape[n].value;
+	CHECK( sum == 4 );
+}
+
+TEST_CASE( "Append only tape concurrent producers and consumer", "[tape]" ) {
+	const int producers = 4, count = 50000;
+	container::append_only_tape<std::pair<int, int> > tape;
+	std::atomic<int> running(producers);
+
+	// Consumer following the published elements while they are appended
+	std::vector<int> seen(producers, 0);
+	bool ordered = true;
+	std::thread consumer([&](){
+		std::size_t pos = 0;
+		while(running.load() > 0 || pos < tape.size())
+		{
+			std::size_t end = tape.published(pos);
+			for(; pos < end; ++pos)
+			{
+				const std::pair<int, int>& rec = tape[pos];
+				// Each producer appends its records in order
+				if(rec.second != seen[rec.first]++)
+					ordered = false;
+			}
+		}
+	});
+
+	std::vector<std::thread> threads;
+	for(int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread([&, p](){
+			for(int n = 0; n < count; ++n)
+				tape.emplace_back(p, n);
+			--running;
+		}));
+	}
+	for(std::size_t p = 0; p < threads.size(); ++p)
+		threads[p].join();
+	consumer.join();
+
+	CHECK( tape.size() == (std::size_t)(producers * count) );
+	CHECK( tape.published() == tape.size() );
+	CHECK( ordered );
+	for(int p = 0; p < producers; ++p)
+		CHECK( seen[p] == count );
+}
+
+/** Allocator counting its allocations, from any thread. */
+template<typename T>
+struct counting_segment_allocator : std::allocator<T>
+{
+	template<typename U> struct rebind { typedef counting_segment_allocator<U> other; };
+
+	std::atomic<int>* allocations;
+
+	explicit counting_segment_allocator(std::atomic<int>* allocations):allocations(allocations) {}
+	template<typename U> counting_segment_allocator(const counting_segment_allocator<U>& a):allocations(a.allocations) {}
+
+	T* allocate(std::size_t n) {++*allocations; return std::allocator<T>::allocate(n);}
+};
+
+TEST_CASE( "Append only tape allocates each segment once", "[tape]" ) {
+	std::atomic<int> allocations(0);
+	{
+		container::append_only_tape<int, counting_segment_allocator<int> > tape{counting_segment_allocator<int>(&allocations)};
+		for(int n = 0; n < 32; ++n)
+			tape.push_back(n);
+		CHECK( allocations == 1 );
+		// The middle of the first segment installs the second one ahead
+		tape.push_back(32);
+		CHECK( allocations == 2 );
+		for(int n = 33; n < 40000; ++n)
+			tape.push_back(n);
+		CHECK( tape.published() == (std::size_t)40000 );
+	}
+	// 40000 elements fill the segments of 64 to 32768 slots, without reaching the middle of the last one
+	CHECK( allocations == 10 );
+}
@@ -0,0 +1,229 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_TESTS_BENCH_HPP
+#define CPPCONTAINERS_TESTS_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_perf.hpp"
+
+
+/**
+ * Minimal benchmark harness.
+ *
+ * Benchmark suites are registered with BENCH_SUITE and run by bench_runner.cpp.
+ * Each measure is printed as one CSV line on standard output:
+ *
+ *     suite,operation,container,type,count,items,ns,ns_per_item,cycles,instructions,l1d_misses,llc_misses,dtlb_misses,branch_misses,peak_bytes
+ *
+ * where count is the container size the case works on, items the number of
+ * elementary operations timed, ns the best wall-clock time over all repetitions.
+ * Hardware counters of the best repetition are reported when enabled with the perf option
+ * and available on the system (see perf_counters), their columns are left empty otherwise.
+ * peak_bytes is the peak memory reported by cases measuring it, and is left empty by others.
+ */
+namespace bench
+{
+
+	/** Prevent the compiler from optimizing away a computed value. */
+	template<typename T>
+	inline void do_not_optimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	/** Run options, filled from command line by the runner. */
+	struct options
+	{
+		std::size_t min_count;	//!< Smallest container size of the sweep.
+		std::size_t max_count;	//!< Biggest container size of the sweep.
+		unsigned    repeat;		//!< Number of repetitions of each case, the best one is kept.
+		std::string filter;		//!< Only run cases whose "suite/operation/container/type" contains this string.
+		bool        perf;		//!< Record hardware performance counters.
+
+		options():min_count(100), max_count(1000000), repeat(3), perf(false) {}
+	};
+
+	/**
+	 * Stopwatch passed to each benchmark case.
+	 * The case prepares its data, then brackets the measured code with start() and stop().
+	 */
+	class stopwatch
+	{
+		typedef std::chrono::steady_clock clock;
+
+		clock::time_point _begin;
+		std::uint64_t     _ns;
+		std::size_t       _items;
+		std::size_t       _bytes;
+		perf_counters*    _perf;
+		perf_counters::sample _counters;
+
+	public:
+		stopwatch(perf_counters* perf = nullptr):_ns(0), _items(0), _bytes(0), _perf(perf){}
+
+		void start()
+		{
+			if(_perf)
+				_perf->start();
+			_begin = clock::now();
+		}
+
+		void stop()
+		{
+			clock::time_point end = clock::now();
+			if(_perf)
+				_counters += _perf->stop();
+			_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - _begin).count();
+		}
+
+		/** Set the number of elementary operations done by the measured code. */
+		void items(std::size_t n) {_items = n;}
+
+		/** Set the peak memory used by the measured code, in bytes. */
+		void bytes(std::size_t n) {_bytes = n;}
+
+		std::uint64_t ns() const {return _ns;}
+		std::size_t items() const {return _items;}
+		std::size_t bytes() const {return _bytes;}
+		const perf_counters::sample& counters() const {return _counters;}
+	};
+
+	/** Run benchmark cases and report their results. */
+	class runner
+	{
+		options       _opts;
+		std::ostream& _out;
+		std::string   _suite;
+		perf_counters _perf;
+
+	public:
+		runner(const options& opts, std::ostream& out = std::cout):
+		_opts(opts), _out(out)
+		{
+			if(_opts.perf && !_perf.open())
+				std::cerr << "Hardware performance counters are not available, reporting wall-clock time only." << std::endl;
+		}
+
+		const options& opts() const {return _opts;}
+
+		void suite(const std::string& name) {_suite = name;}
+
+		/** Container sizes to sweep: powers of ten from min_count to max_count. */
+		std::vector<std::size_t> counts() const
+		{
+			std::vector<std::size_t> res;
+			for(std::size_t n = 1; n <= _opts.max_count; n *= 10)
+			{
+				if(n >= _opts.min_count)
+					res.push_back(n);
+				if(n > std::numeric_limits<std::size_t>::max() / 10)
+					break;
+			}
+			return res;
+		}
+
+		/** Tell if a case is selected by the filter option. */
+		bool selected(const std::string& op, const std::string& container, const std::string& type) const
+		{
+			return _opts.filter.empty()
+				|| (_suite + "/" + op + "/" + container + "/" + type).find(_opts.filter) != std::string::npos;
+		}
+
+		/** Print CSV header line. */
+		void header()
+		{
+			_out << "suite,operation,container,type,count,items,ns,ns_per_item";
+			for(int e = 0; e < perf_counters::event_count; ++e)
+				_out << ',' << perf_counters::name(e);
+			_out << ",peak_bytes" << std::endl;
+		}
+
+		/**
+		 * Run a benchmark case opts().repeat times and print its best time.
+		 * \param fn Callable taking a stopwatch&, called once per repetition.
+		 */
+		template<typename Fn>
+		void run(const std::string& op, const std::string& container, const std::string& type, std::size_t count, Fn fn)
+		{
+			if(!selected(op, container, type))
+				return;
+
+			std::uint64_t best = std::numeric_limits<std::uint64_t>::max();
+			std::size_t items = count, bytes = 0;
+			perf_counters::sample counters;
+			for(unsigned r = 0; r < _opts.repeat; ++r)
+			{
+				stopwatch sw(_perf.available() ? &_perf : nullptr);
+				sw.items(count);
+				fn(sw);
+				if(sw.ns() < best)
+				{
+					best = sw.ns();
+					counters = sw.counters();
+				}
+				items = sw.items();
+				bytes = sw.bytes();
+			}
+
+			_out << _suite << ',' << op << ',' << container << ',' << type << ','
+				<< count << ',' << items << ',' << best << ','
+				<< (items ? double(best) / double(items) : 0.0);
+			for(int e = 0; e < perf_counters::event_count; ++e)
+			{
+				_out << ',';
+				if(counters.valid[e])
+					_out << counters.value[e];
+			}
+			_out << ',';
+			if(bytes)
+				_out << bytes;
+			_out << std::endl;
+		}
+	};
+
+	typedef void (*suite_fn)(runner&);
+
+	/** Registered benchmark suites. */
+	inline std::vector<std::pair<const char*, suite_fn> >& suites()
+	{
+		static std::vector<std::pair<const char*, suite_fn> > s;
+		return s;
+	}
+
+	/** Register a benchmark suite at static initialization time. */
+	struct registrar
+	{
+		registrar(const char* name, suite_fn fn)
+		{
+			suites().push_back(std::make_pair(name, fn));
+		}
+	};
+
+} // namespace bench
+
+/** Declare and register a benchmark suite. */
+#define BENCH_SUITE(name) \
+	static void bench_suite_##name(bench::runner&); \
+	static bench::registrar bench_registrar_##name(#name, &bench_suite_##name); \
+	static void bench_suite_##name(bench::runner& runner)
+
+#endif // CPPCONTAINERS_TESTS_BENCH_HPP
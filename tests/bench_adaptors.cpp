@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "tape_adaptors.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace
+{
+	template<typename T> T make_value(std::size_t i);
+	template<> int make_value<int>(std::size_t i) {return (int)(i * 2654435761u);}
+	template<> std::string make_value<std::string>(std::size_t i) {return std::string(24, char('a' + (i * 2654435761u) % 26));} // Longer than SSO
+
+	template<typename T> const char* type_name();
+	template<> const char* type_name<int>() {return "int";}
+	template<> const char* type_name<std::string>() {return "string";}
+
+	/** Queue keeping a window of n elements: n pushes, then n pushes each followed by a pop. */
+	template<class Q>
+	void bench_queue(bench::runner& runner, const char* cname, std::size_t n, Q proto)
+	{
+		typedef typename Q::value_type T;
+		runner.run("queue", cname, type_name<T>(), n, [&](bench::stopwatch& sw){
+			Q q(proto);
+			sw.start();
+			for(std::size_t i = 0; i < n; ++i)
+				q.push(make_value<T>(i));
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				q.push(make_value<T>(i));
+				q.pop();
+			}
+			sw.stop();
+			sw.items(2 * n);
+			bench::do_not_optimize(q);
+		});
+	}
+
+	/** n pushes then n pops. */
+	template<class S>
+	void bench_stack(bench::runner& runner, const char* cname, std::size_t n)
+	{
+		typedef typename S::value_type T;
+		runner.run("stack", cname, type_name<T>(), n, [&](bench::stopwatch& sw){
+			S s;
+			std::size_t sum = 0;
+			sw.start();
+			for(std::size_t i = 0; i < n; ++i)
+				s.push(make_value<T>(i));
+			for(; !s.empty(); s.pop())
+				sum += sizeof(s.top());
+			sw.stop();
+			sw.items(2 * n);
+			bench::do_not_optimize(sum);
+		});
+	}
+
+	/** n pushes of unordered values then n pops. */
+	template<class P>
+	void bench_priority_queue(bench::runner& runner, const char* cname, std::size_t n)
+	{
+		typedef typename P::value_type T;
+		runner.run("priority_queue", cname, type_name<T>(), n, [&](bench::stopwatch& sw){
+			P p;
+			std::size_t sum = 0;
+			sw.start();
+			for(std::size_t i = 0; i < n; ++i)
+				p.push(make_value<T>(i));
+			for(; !p.empty(); p.pop())
+				sum += sizeof(p.top());
+			sw.stop();
+			sw.items(2 * n);
+			bench::do_not_optimize(sum);
+		});
+	}
+
+	template<typename T>
+	void bench_type(bench::runner& runner)
+	{
+		typedef container::tape<T, std::allocator<T>, container::tape_no_stats, container::tape_shrink_policy> sliding_tape;
+		sliding_tape sliding;
+		sliding.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+
+			bench_queue(runner, "tape", n, container::queue<T>());
+			bench_queue(runner, "tape/sliding", n, container::queue<T, sliding_tape>(sliding));
+			bench_queue(runner, "deque", n, std::queue<T, std::deque<T> >());
+
+			bench_stack<container::stack<T> >(runner, "tape", n);
+			bench_stack<std::stack<T, std::deque<T> > >(runner, "deque", n);
+			bench_stack<std::stack<T, std::vector<T> > >(runner, "vector", n);
+
+			bench_priority_queue<container::priority_queue<T> >(runner, "tape", n);
+			bench_priority_queue<std::priority_queue<T, std::deque<T> > >(runner, "deque", n);
+			bench_priority_queue<std::priority_queue<T, std::vector<T> > >(runner, "vector", n);
+		}
+	}
+}
+
+BENCH_SUITE(adaptors)
+{
+	bench_type<int>(runner);
+	bench_type<std::string>(runner);
+}
@@ -0,0 +1,90 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "append_only_tape.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/** 32-byte fixed size log record. */
+	struct log_record
+	{
+		std::uint64_t	time;
+		std::uint32_t	thread;
+		std::uint32_t	sequence;
+		char			message[16];
+
+		log_record(std::uint64_t t, std::uint32_t th, std::uint32_t seq):time(t), thread(th), sequence(seq) {message[0] = 0;}
+	};
+
+	/** Tape guarded by a mutex, the usual way to share a container between producers. */
+	struct locked_tape
+	{
+		std::mutex						mutex;
+		container::tape<log_record>		records;
+
+		void emplace_back(std::uint64_t t, std::uint32_t th, std::uint32_t seq)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			records.emplace_back(t, th, seq);
+		}
+	};
+
+	/** Appends n records from threads threads, each appending its share. */
+	template<class C>
+	void append(C& c, std::size_t n, unsigned threads)
+	{
+		std::vector<std::thread> workers;
+		for(unsigned t = 0; t < threads; ++t)
+		{
+			workers.push_back(std::thread([&c, n, threads, t](){
+				std::size_t share = n / threads + (t < n % threads ? 1 : 0);
+				for(std::size_t i = 0; i < share; ++i)
+					c.emplace_back(i, t, (std::uint32_t)i);
+			}));
+		}
+		for(std::size_t t = 0; t < workers.size(); ++t)
+			workers[t].join();
+	}
+}
+
+BENCH_SUITE(append_only)
+{
+	std::vector<std::size_t> counts = runner.counts();
+	for(std::size_t c = 0; c < counts.size(); ++c)
+	{
+		const std::size_t n = counts[c];
+		for(unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u})
+		{
+			std::string op = "append/" + std::to_string(threads);
+
+			runner.run(op.c_str(), "append_only_tape", "record32", n, [&](bench::stopwatch& sw){
+				container::append_only_tape<log_record> records;
+				sw.start();
+				append(records, n, threads);
+				sw.stop();
+				bench::do_not_optimize(records);
+			});
+
+			runner.run(op.c_str(), "mutex+tape", "record32", n, [&](bench::stopwatch& sw){
+				locked_tape records;
+				sw.start();
+				append(records, n, threads);
+				sw.stop();
+				bench::do_not_optimize(records);
+			});
+		}
+	}
+}
@@ -0,0 +1,87 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "tape.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	template<typename T> const char* type_name();
+	template<> const char* type_name<std::uint8_t>() {return "uint8";}
+	template<> const char* type_name<int>() {return "int";}
+	template<> const char* type_name<double>() {return "double";}
+
+	/**
+	 * Standard algorithms on tape iterators, compared with the same algorithms on raw pointers to tape elements,
+	 * which standard libraries lower to memmove/memcmp, and on vector iterators.
+	 */
+	template<typename T>
+	void bench_type(bench::runner& runner)
+	{
+		const char* tname = type_name<T>();
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+			const container::tape<T> src(n, T(1));
+			const std::vector<T> vsrc(n, T(1));
+
+			runner.run("std::copy", "tape", tname, n, [&](bench::stopwatch& sw){
+				container::tape<T> dst(n, T(0));
+				sw.start();
+				std::copy(src.begin(), src.end(), dst.begin());
+				sw.stop();
+				bench::do_not_optimize(dst);
+			});
+
+			runner.run("std::copy", "tape/data", tname, n, [&](bench::stopwatch& sw){
+				container::tape<T> dst(n, T(0));
+				sw.start();
+				std::copy(src.data(), src.data() + n, dst.data());
+				sw.stop();
+				bench::do_not_optimize(dst);
+			});
+
+			runner.run("std::copy", "vector", tname, n, [&](bench::stopwatch& sw){
+				std::vector<T> dst(n, T(0));
+				sw.start();
+				std::copy(vsrc.begin(), vsrc.end(), dst.begin());
+				sw.stop();
+				bench::do_not_optimize(dst);
+			});
+
+			runner.run("std::equal", "tape", tname, n, [&](bench::stopwatch& sw){
+				container::tape<T> other(src);
+				sw.start();
+				bool eq = std::equal(src.begin(), src.end(), other.begin());
+				sw.stop();
+				bench::do_not_optimize(eq);
+			});
+
+			runner.run("std::equal", "tape/data", tname, n, [&](bench::stopwatch& sw){
+				container::tape<T> other(src);
+				sw.start();
+				bool eq = std::equal(src.data(), src.data() + n, other.data());
+				sw.stop();
+				bench::do_not_optimize(eq);
+			});
+		}
+	}
+}
+
+BENCH_SUITE(copy)
+{
+	bench_type<std::uint8_t>(runner);
+	bench_type<int>(runner);
+	bench_type<double>(runner);
+}
@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "parallel_sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace
+{
+	template<typename T> T make_value(std::mt19937_64& rng);
+	template<> std::uint64_t make_value<std::uint64_t>(std::mt19937_64& rng) {return rng();}
+	template<> std::string make_value<std::string>(std::mt19937_64& rng) {return std::to_string(rng());}
+
+	template<typename T> const char* type_name();
+	template<> const char* type_name<std::uint64_t>() {return "uint64";}
+	template<> const char* type_name<std::string>() {return "string";}
+
+	template<typename T, typename Fn>
+	void bench_sort(bench::runner& runner, const char* algo, const container::tape<T>& data, Fn fn)
+	{
+		runner.run("parallel_sort", algo, type_name<T>(), data.size(), [&](bench::stopwatch& sw){
+			container::tape<T> t(data);
+			sw.start();
+			fn(t);
+			sw.stop();
+			bench::do_not_optimize(t);
+		});
+	}
+
+	template<typename T>
+	void bench_type(bench::runner& runner)
+	{
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+			std::mt19937_64 rng(n);
+			container::tape<T> data;
+			data.reserve(n);
+			for(std::size_t i = 0; i < n; ++i)
+				data.push_back(make_value<T>(rng));
+
+			bench_sort(runner, "std::sort", data, [](container::tape<T>& t){std::sort(t.begin(), t.end());});
+			for(unsigned threads : {2u, 4u, 8u})
+			{
+				std::string algo = "parallel_sort/" + std::to_string(threads);
+				bench_sort(runner, algo.c_str(), data, [threads](container::tape<T>& t){container::parallel_sort(t, threads);});
+			}
+		}
+	}
+}
+
+BENCH_SUITE(parallel_sort)
+{
+	bench_type<std::uint64_t>(runner);
+	bench_type<std::string>(runner);
+}
@@ -0,0 +1,237 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#ifndef CPPCONTAINERS_TESTS_BENCH_PERF_HPP
+#define CPPCONTAINERS_TESTS_BENCH_PERF_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace bench
+{
+
+	/**
+	 * Hardware performance counters of the calling thread, read through Linux perf_event_open.
+	 *
+	 * Counters are opened as one group so they are scheduled together on the PMU,
+	 * and scaled when the kernel multiplexes them.
+	 * Counters which cannot be opened (no PMU access, virtual machine, perf_event_paranoid, non Linux system)
+	 * are reported as unavailable, the benchmarks then fall back to wall-clock time only.
+	 */
+	class perf_counters
+	{
+	public:
+		enum event
+		{
+			cycles,
+			instructions,
+			l1d_misses,
+			llc_misses,
+			dtlb_misses,
+			branch_misses,
+			event_count
+		};
+
+		/** Values of counters for a measured section. */
+		struct sample
+		{
+			bool          valid[event_count];
+			std::uint64_t value[event_count];
+
+			sample()
+			{
+				for(int e = 0; e < event_count; ++e)
+				{
+					valid[e] = false;
+					value[e] = 0;
+				}
+			}
+
+			sample& operator+=(const sample& s)
+			{
+				for(int e = 0; e < event_count; ++e)
+				{
+					valid[e] = s.valid[e];
+					value[e] += s.value[e];
+				}
+				return *this;
+			}
+		};
+
+		/** CSV column name of an event. */
+		static const char* name(int e)
+		{
+			static const char* names[event_count] = {
+				"cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses", "branch_misses"
+			};
+			return names[e];
+		}
+
+	private:
+		int           _fd[event_count];
+		std::uint64_t _id[event_count];
+		int           _leader;
+
+	public:
+		perf_counters():_leader(-1)
+		{
+			for(int e = 0; e < event_count; ++e)
+				_fd[e] = -1;
+		}
+
+		~perf_counters()
+		{
+			close();
+		}
+
+		/** Open counters. Return true if at least one counter is available. */
+		bool open()
+		{
+#ifdef __linux__
+			for(int e = 0; e < event_count; ++e)
+			{
+				struct perf_event_attr attr;
+				std::memset(&attr, 0, sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.disabled = _leader < 0 ? 1 : 0;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID
+					| PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+				_config(e, attr);
+
+				_fd[e] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, _leader, 0);
+				if(_fd[e] < 0)
+					continue;
+				if(ioctl(_fd[e], PERF_EVENT_IOC_ID, &_id[e]) < 0)
+				{
+					::close(_fd[e]);
+					_fd[e] = -1;
+					continue;
+				}
+				if(_leader < 0)
+					_leader = _fd[e];
+			}
+#endif
+			return available();
+		}
+
+		/** Close all counters. */
+		void close()
+		{
+#ifdef __linux__
+			// Close followers before group leader.
+			for(int e = event_count - 1; e >= 0; --e)
+				if(_fd[e] >= 0)
+					::close(_fd[e]);
+#endif
+			for(int e = 0; e < event_count; ++e)
+				_fd[e] = -1;
+			_leader = -1;
+		}
+
+		bool available() const
+		{
+			return _leader >= 0;
+		}
+
+		/** Reset and start counting. */
+		void start()
+		{
+#ifdef __linux__
+			if(_leader >= 0)
+			{
+				ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			}
+#endif
+		}
+
+		/** Stop counting and return counted values since start(). */
+		sample stop()
+		{
+			sample s;
+#ifdef __linux__
+			if(_leader >= 0)
+			{
+				ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+				// Layout of PERF_FORMAT_GROUP read: nr, time_enabled, time_running, {value, id}[nr]
+				std::uint64_t buf[3 + 2 * event_count];
+				if(read(_leader, buf, sizeof(buf)) > 0)
+				{
+					std::uint64_t nr = buf[0], enabled = buf[1], running = buf[2];
+					double scale = running ? double(enabled) / double(running) : 0.0;
+					for(std::uint64_t n = 0; n < nr && n < event_count; ++n)
+					{
+						for(int e = 0; e < event_count; ++e)
+						{
+							if(_fd[e] >= 0 && _id[e] == buf[4 + 2 * n])
+							{
+								s.valid[e] = running > 0;
+								s.value[e] = (std::uint64_t)(double(buf[3 + 2 * n]) * scale);
+							}
+						}
+					}
+				}
+			}
+#endif
+			return s;
+		}
+
+	private:
+#ifdef __linux__
+		static void _config(int e, struct perf_event_attr& attr)
+		{
+			switch(e)
+			{
+			case cycles:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_CPU_CYCLES;
+				break;
+			case instructions:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+				break;
+			case l1d_misses:
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = _cache_miss(PERF_COUNT_HW_CACHE_L1D);
+				break;
+			case llc_misses:
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = _cache_miss(PERF_COUNT_HW_CACHE_LL);
+				break;
+			case dtlb_misses:
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = _cache_miss(PERF_COUNT_HW_CACHE_DTLB);
+				break;
+			case branch_misses:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+				break;
+			}
+		}
+
+		static std::uint64_t _cache_miss(std::uint64_t cache)
+		{
+			return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		}
+#endif
+	};
+
+} // namespace bench
+
+#endif // CPPCONTAINERS_TESTS_BENCH_PERF_HPP
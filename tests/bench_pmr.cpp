@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "tape.hpp"
+
+#ifdef CONTAINER_TAPE_HAS_PMR
+
+#include <vector>
+
+namespace
+{
+	/** Number of elements pushed by each simulated request. */
+	const std::size_t request_size = 100;
+
+	/**
+	 * Memory resource to test, recreated for each repetition.
+	 */
+	struct resource
+	{
+		std::vector<char> arena;
+		std::pmr::monotonic_buffer_resource monotonic;
+		std::pmr::unsynchronized_pool_resource pool;
+
+		resource(std::size_t bytes):
+		arena(bytes),
+		monotonic(arena.data(), arena.size())
+		{}
+
+		std::pmr::memory_resource* get(const std::string& name)
+		{
+			if(name == "monotonic")
+				return &monotonic;
+			if(name == "pool")
+				return &pool;
+			return std::pmr::new_delete_resource();
+		}
+
+		void release(const std::string& name)
+		{
+			if(name == "monotonic")
+				monotonic.release();
+		}
+	};
+
+	template<class C>
+	void bench_resource(bench::runner& runner, const std::string& cname, const std::string& rname)
+	{
+		std::string name = cname + "/" + rname;
+
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+
+			// Fill a container then destroy it.
+			runner.run("fill", name, "int", n, [&](bench::stopwatch& sw){
+				resource res(8 * n * sizeof(int));
+				sw.start();
+				{
+					C cont(res.get(rname));
+					for(std::size_t i = 0; i < n; ++i)
+						cont.push_back((int)i);
+					bench::do_not_optimize(cont);
+				}
+				sw.stop();
+			});
+
+			// Many short-lived containers, arena released after each request.
+			runner.run("requests", name, "int", n, [&](bench::stopwatch& sw){
+				resource res(8 * request_size * sizeof(int));
+				sw.start();
+				for(std::size_t r = 0; r < n; r += request_size)
+				{
+					{
+						C cont(res.get(rname));
+						for(std::size_t i = 0; i < request_size; ++i)
+							cont.push_back((int)i);
+						bench::do_not_optimize(cont);
+					}
+					res.release(rname);
+				}
+				sw.stop();
+			});
+		}
+	}
+
+	template<class C>
+	void bench_container(bench::runner& runner, const std::string& cname)
+	{
+		bench_resource<C>(runner, cname, "new_delete");
+		bench_resource<C>(runner, cname, "monotonic");
+		bench_resource<C>(runner, cname, "pool");
+	}
+}
+
+BENCH_SUITE(pmr)
+{
+	bench_container<container::pmr::tape<int> >(runner, "tape");
+	bench_container<std::pmr::vector<int> >(runner, "vector");
+}
+
+#endif // CONTAINER_TAPE_HAS_PMR
@@ -0,0 +1,98 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace
+{
+	/** 16-byte record sorted by its key. */
+	struct record
+	{
+		std::uint64_t key;
+		std::uint64_t payload;
+	};
+
+	struct record_key
+	{
+		std::uint64_t operator()(const record& r) const {return r.key;}
+	};
+
+	struct record_less
+	{
+		bool operator()(const record& a, const record& b) const {return a.key < b.key;}
+	};
+
+	template<typename T> T make_value(std::mt19937_64& rng);
+	template<> std::uint32_t make_value<std::uint32_t>(std::mt19937_64& rng) {return (std::uint32_t)rng();}
+	template<> double make_value<double>(std::mt19937_64& rng) {return (double)(std::int64_t)rng() / 1e9;}
+	template<> record make_value<record>(std::mt19937_64& rng) {record r = {rng(), 0}; return r;}
+
+	template<typename T> const char* type_name();
+	template<> const char* type_name<std::uint32_t>() {return "uint32";}
+	template<> const char* type_name<double>() {return "double";}
+	template<> const char* type_name<record>() {return "record";}
+
+	template<typename T> struct sort_traits
+	{
+		typedef std::less<T> less;
+		static void radix(container::tape<T>& t) {container::radix_sort(t);}
+	};
+
+	template<> struct sort_traits<record>
+	{
+		typedef record_less less;
+		static void radix(container::tape<record>& t) {container::radix_sort(t, record_key());}
+	};
+
+	template<typename T, typename Fn>
+	void bench_sort(bench::runner& runner, const char* algo, const container::tape<T>& data, Fn fn)
+	{
+		runner.run("sort", algo, type_name<T>(), data.size(), [&](bench::stopwatch& sw){
+			container::tape<T> t(data);
+			sw.start();
+			fn(t);
+			sw.stop();
+			bench::do_not_optimize(t);
+		});
+	}
+
+	template<typename T>
+	void bench_type(bench::runner& runner)
+	{
+		typedef typename sort_traits<T>::less less;
+
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+			std::mt19937_64 rng(n);
+			container::tape<T> data;
+			data.reserve(n);
+			for(std::size_t i = 0; i < n; ++i)
+				data.push_back(make_value<T>(rng));
+
+			bench_sort(runner, "radix_sort", data, [](container::tape<T>& t){sort_traits<T>::radix(t);});
+			bench_sort(runner, "std::sort", data, [](container::tape<T>& t){std::sort(t.begin(), t.end(), less());});
+			bench_sort(runner, "std::stable_sort", data, [](container::tape<T>& t){std::stable_sort(t.begin(), t.end(), less());});
+		}
+	}
+}
+
+BENCH_SUITE(sort)
+{
+	bench_type<std::uint32_t>(runner);
+	bench_type<double>(runner);
+	bench_type<record>(runner);
+}
@@ -0,0 +1,190 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "reverse_encoder.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/**
+	 * Encoded messages, protobuf-like:
+	 *
+	 *     message Point  {sint64 x = 1; sint64 y = 2;}
+	 *     message Record {uint64 id = 1; string name = 2; Point pos = 3;}
+	 *     message Batch  {repeated Record records = 1;}
+	 */
+	struct record
+	{
+		std::uint64_t id;
+		std::string   name;
+		std::int64_t  x, y;
+	};
+
+	std::vector<record> make_records(std::size_t n)
+	{
+		std::vector<record> res(n);
+		for(std::size_t i = 0; i < n; ++i)
+		{
+			res[i].id   = i * 2654435761u;
+			res[i].name = "record-" + std::to_string(i);
+			res[i].x    = (std::int64_t)i - (std::int64_t)(n / 2);
+			res[i].y    = (std::int64_t)(i * i % 1000);
+		}
+		return res;
+	}
+
+	/** Single pass encoding, last record and last field first. */
+	std::size_t encode_reverse(const record* records, std::size_t count, container::reverse_encoder& enc)
+	{
+		for(std::size_t i = count; i-- > 0;)
+		{
+			const record& r = records[i];
+			enc.put_message_field(1, [&r](container::reverse_encoder& e){
+				e.put_message_field(3, [&r](container::reverse_encoder& p){
+					p.put_svarint(r.y);
+					p.put_tag(2, container::reverse_encoder::varint_type);
+					p.put_svarint(r.x);
+					p.put_tag(1, container::reverse_encoder::varint_type);
+				});
+				e.put_bytes_field(2, r.name.data(), r.name.size());
+				e.put_varint_field(1, r.id);
+			});
+		}
+		return enc.size();
+	}
+
+	/** Classic encoder: sizes of nested messages are computed by a first pass, then data are written forward. */
+	struct two_pass
+	{
+		static std::size_t varint_size(std::uint64_t v)
+		{
+			std::size_t n = 1;
+			while(v >= 0x80)
+			{
+				v >>= 7;
+				++n;
+			}
+			return n;
+		}
+
+		static std::uint64_t zigzag(std::int64_t v) {return ((std::uint64_t)v << 1) ^ (std::uint64_t)(v >> 63);}
+
+		static std::uint8_t* put_varint(std::uint8_t* p, std::uint64_t v)
+		{
+			while(v >= 0x80)
+			{
+				*p++ = (std::uint8_t)(v | 0x80);
+				v >>= 7;
+			}
+			*p++ = (std::uint8_t)v;
+			return p;
+		}
+
+		std::vector<std::size_t> point_sizes, record_sizes;
+		std::vector<std::uint8_t> out;
+
+		std::size_t encode(const record* records, std::size_t count)
+		{
+			// Size pass
+			point_sizes.resize(count);
+			record_sizes.resize(count);
+			std::size_t total = 0;
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				const record& r = records[i];
+				point_sizes[i] = 1 + varint_size(zigzag(r.x)) + 1 + varint_size(zigzag(r.y));
+				record_sizes[i] = 1 + varint_size(r.id)
+					+ 1 + varint_size(r.name.size()) + r.name.size()
+					+ 1 + varint_size(point_sizes[i]) + point_sizes[i];
+				total += 1 + varint_size(record_sizes[i]) + record_sizes[i];
+			}
+
+			// Write pass
+			out.resize(total);
+			std::uint8_t* p = out.data();
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				const record& r = records[i];
+				*p++ = (1 << 3) | 2;
+				p = put_varint(p, record_sizes[i]);
+				*p++ = (1 << 3) | 0;
+				p = put_varint(p, r.id);
+				*p++ = (2 << 3) | 2;
+				p = put_varint(p, r.name.size());
+				std::memcpy(p, r.name.data(), r.name.size());
+				p += r.name.size();
+				*p++ = (3 << 3) | 2;
+				p = put_varint(p, point_sizes[i]);
+				*p++ = (1 << 3) | 0;
+				p = put_varint(p, zigzag(r.x));
+				*p++ = (2 << 3) | 0;
+				p = put_varint(p, zigzag(r.y));
+			}
+			return total;
+		}
+	};
+}
+
+BENCH_SUITE(reverse_encoder)
+{
+	std::vector<std::size_t> counts = runner.counts();
+	for(std::size_t c = 0; c < counts.size(); ++c)
+	{
+		const std::size_t n = counts[c];
+		std::vector<record> records = make_records(n);
+
+		// Encode a batch of n records in a new buffer.
+		runner.run("encode", "reverse_encoder", "record", n, [&](bench::stopwatch& sw){
+			sw.start();
+			container::reverse_encoder enc;
+			std::size_t size = encode_reverse(records.data(), n, enc);
+			bench::do_not_optimize(enc);
+			sw.stop();
+			bench::do_not_optimize(size);
+		});
+
+		runner.run("encode", "two_pass", "record", n, [&](bench::stopwatch& sw){
+			sw.start();
+			two_pass enc;
+			std::size_t size = enc.encode(records.data(), n);
+			bench::do_not_optimize(enc);
+			sw.stop();
+			bench::do_not_optimize(size);
+		});
+
+		// Encode n records one by one, reusing the buffer as for a stream of messages.
+		runner.run("encode_each", "reverse_encoder", "record", n, [&](bench::stopwatch& sw){
+			container::reverse_encoder enc;
+			std::size_t total = 0;
+			sw.start();
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				enc.clear();
+				total += encode_reverse(&records[i], 1, enc);
+			}
+			sw.stop();
+			bench::do_not_optimize(total);
+		});
+
+		runner.run("encode_each", "two_pass", "record", n, [&](bench::stopwatch& sw){
+			two_pass enc;
+			std::size_t total = 0;
+			sw.start();
+			for(std::size_t i = 0; i < n; ++i)
+				total += enc.encode(&records[i], 1);
+			sw.stop();
+			bench::do_not_optimize(total);
+		});
+	}
+}
@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+static void usage(const char* prog)
+{
+	std::cerr << "Usage: " << prog << " [options]\n"
+		<< "  --min=N      smallest container size of the sweep (default 1e2)\n"
+		<< "  --max=N      biggest container size of the sweep (default 1e6, up to 1e8)\n"
+		<< "  --repeat=N   repetitions of each case, best time is reported (default 3)\n"
+		<< "  --filter=S   only run cases whose suite/operation/container/type contains S\n"
+		<< "  --perf       record hardware performance counters (Linux perf_event_open)\n"
+		<< "Results are written as CSV on standard output." << std::endl;
+}
+
+static bool option(const char* arg, const char* name, const char*& value)
+{
+	std::size_t len = std::strlen(name);
+	if(std::strncmp(arg, name, len) == 0 && arg[len] == '=')
+	{
+		value = arg + len + 1;
+		return true;
+	}
+	return false;
+}
+
+int main(int argc, char* argv[])
+{
+	bench::options opts;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		const char* value;
+		if(option(argv[i], "--min", value))
+			opts.min_count = (std::size_t)std::strtod(value, nullptr);
+		else if(option(argv[i], "--max", value))
+			opts.max_count = (std::size_t)std::strtod(value, nullptr);
+		else if(option(argv[i], "--repeat", value))
+			opts.repeat = (unsigned)std::strtoul(value, nullptr, 10);
+		else if(option(argv[i], "--filter", value))
+			opts.filter = value;
+		else if(std::strcmp(argv[i], "--perf") == 0)
+			opts.perf = true;
+		else
+		{
+			usage(argv[0]);
+			return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+	if(opts.repeat == 0)
+		opts.repeat = 1;
+
+	bench::runner runner(opts);
+	runner.header();
+	for(std::size_t n = 0; n < bench::suites().size(); ++n)
+	{
+		runner.suite(bench::suites()[n].first);
+		bench::suites()[n].second(runner);
+	}
+	return 0;
+}
@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "sharded_tape.hpp"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	template<typename T> T make_value(std::size_t i);
+	template<> int make_value<int>(std::size_t i) {return (int)i;}
+	template<> std::string make_value<std::string>(std::size_t i) {return std::string(24, char('a' + i % 26));} // Longer than SSO
+
+	template<typename T> const char* type_name();
+	template<> const char* type_name<int>() {return "int";}
+	template<> const char* type_name<std::string>() {return "string";}
+
+	/** Tape guarded by a mutex, the usual way to share a container between producers. */
+	template<typename T>
+	struct locked_tape
+	{
+		std::mutex				mutex;
+		container::tape<T>		elements;
+
+		void push_back(const T& val)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			elements.push_back(val);
+		}
+
+		container::tape<T> collect() {return std::move(elements);}
+	};
+
+	/** Pushes n elements from threads threads, each pushing its share, then collects them in a single tape. */
+	template<typename T, class C>
+	container::tape<T> produce(C& c, std::size_t n, unsigned threads)
+	{
+		std::vector<std::thread> workers;
+		for(unsigned t = 0; t < threads; ++t)
+		{
+			workers.push_back(std::thread([&c, n, threads, t](){
+				for(std::size_t i = t; i < n; i += threads)
+					c.push_back(make_value<T>(i));
+			}));
+		}
+		for(std::size_t t = 0; t < workers.size(); ++t)
+			workers[t].join();
+		return c.collect();
+	}
+
+	template<typename T>
+	void bench_type(bench::runner& runner)
+	{
+		const char* tname = type_name<T>();
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+			for(unsigned threads : {1u, 2u, 4u, 8u})
+			{
+				std::string op = "produce/" + std::to_string(threads);
+
+				runner.run(op.c_str(), "sharded_tape", tname, n, [&](bench::stopwatch& sw){
+					container::sharded_tape<T> shards;
+					sw.start();
+					container::tape<T> all = produce<T>(shards, n, threads);
+					sw.stop();
+					bench::do_not_optimize(all);
+				});
+
+				runner.run(op.c_str(), "sharded_tape/ordered", tname, n, [&](bench::stopwatch& sw){
+					container::sharded_tape<T> shards(true);
+					sw.start();
+					container::tape<T> all = produce<T>(shards, n, threads);
+					sw.stop();
+					bench::do_not_optimize(all);
+				});
+
+				runner.run(op.c_str(), "mutex+tape", tname, n, [&](bench::stopwatch& sw){
+					locked_tape<T> locked;
+					sw.start();
+					container::tape<T> all = produce<T>(locked, n, threads);
+					sw.stop();
+					bench::do_not_optimize(all);
+				});
+			}
+		}
+	}
+}
+
+BENCH_SUITE(sharded)
+{
+	bench_type<int>(runner);
+	bench_type<std::string>(runner);
+}
@@ -0,0 +1,146 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "tape.hpp"
+
+#include <deque>
+#include <string>
+
+namespace
+{
+	/** Live and peak bytes allocated through a peak_allocator. */
+	struct memory_meter
+	{
+		std::size_t live;
+		std::size_t peak;
+
+		memory_meter():live(0), peak(0) {}
+	};
+
+	/** Allocator recording the peak of memory allocated by a container. */
+	template<typename T>
+	struct peak_allocator
+	{
+		typedef T value_type;
+		template<typename U> struct rebind { typedef peak_allocator<U> other; };
+
+		memory_meter* meter;
+
+		explicit peak_allocator(memory_meter* meter):meter(meter) {}
+		template<typename U> peak_allocator(const peak_allocator<U>& a):meter(a.meter) {}
+
+		T* allocate(std::size_t n)
+		{
+			meter->live += n * sizeof(T);
+			if(meter->live > meter->peak)
+				meter->peak = meter->live;
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n)
+		{
+			meter->live -= n * sizeof(T);
+			::operator delete(p);
+		}
+
+		bool operator==(const peak_allocator& a) const {return meter == a.meter;}
+		bool operator!=(const peak_allocator& a) const {return meter != a.meter;}
+	};
+
+	typedef container::tape<int, peak_allocator<int>, container::tape_no_stats, container::tape_shrink_policy> tape_type;
+	typedef std::deque<int, peak_allocator<int> > deque_type;
+
+	/** Number of elements going through the window in each case, so cases run long enough to reach a steady state. */
+	std::size_t traffic(std::size_t window) {return window * 20 > 1000000 ? window * 20 : 1000000;}
+
+	/** Batch of elements pushed then popped at each step. */
+	const std::size_t batch = 64;
+
+	/** Per container specifics. */
+	template<class C> struct traits;
+
+	template<> struct traits<tape_type>
+	{
+		static tape_type make(memory_meter* m, bool sliding)
+		{
+			tape_type t{peak_allocator<int>(m)};
+			if(sliding)
+				t.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+			return t;
+		}
+		static void reserve_after(tape_type& c, std::size_t n) {c.reserve_after(n);}
+	};
+
+	template<> struct traits<deque_type>
+	{
+		static deque_type make(memory_meter* m, bool) {return deque_type(peak_allocator<int>(m));}
+		static void reserve_after(deque_type&, std::size_t) {}
+	};
+
+	template<class C>
+	void bench_container(bench::runner& runner, const char* cname, bool sliding)
+	{
+		typedef traits<C> tr;
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t window = counts[c];
+			const std::size_t total = traffic(window);
+
+			// Queue: push_back and pop_front by batches, keeping window elements
+			runner.run("fifo", cname, "int", window, [&](bench::stopwatch& sw){
+				memory_meter meter;
+				C cont = tr::make(&meter, sliding);
+				for(std::size_t i = 0; i < window; ++i)
+					cont.push_back((int)i);
+				sw.start();
+				for(std::size_t i = 0; i < total; i += batch)
+				{
+					for(std::size_t k = 0; k < batch; ++k)
+						cont.push_back((int)(i + k));
+					for(std::size_t k = 0; k < batch; ++k)
+						cont.pop_front();
+				}
+				sw.stop();
+				sw.items(total);
+				sw.bytes(meter.peak);
+				bench::do_not_optimize(cont);
+			});
+
+			// Same queue, reserving room for each batch before pushing it
+			runner.run("fifo_reserve", cname, "int", window, [&](bench::stopwatch& sw){
+				memory_meter meter;
+				C cont = tr::make(&meter, sliding);
+				for(std::size_t i = 0; i < window; ++i)
+					cont.push_back((int)i);
+				sw.start();
+				for(std::size_t i = 0; i < total; i += batch)
+				{
+					tr::reserve_after(cont, batch);
+					for(std::size_t k = 0; k < batch; ++k)
+						cont.push_back((int)(i + k));
+					for(std::size_t k = 0; k < batch; ++k)
+						cont.pop_front();
+				}
+				sw.stop();
+				sw.items(total);
+				sw.bytes(meter.peak);
+				bench::do_not_optimize(cont);
+			});
+		}
+	}
+}
+
+BENCH_SUITE(sliding_window)
+{
+	bench_container<tape_type>(runner, "tape", false);
+	bench_container<tape_type>(runner, "tape/sliding", true);
+	bench_container<deque_type>(runner, "deque", false);
+}
@@ -0,0 +1,254 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "tape.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/** 64-byte trivial element. */
+	struct pod64
+	{
+		int v[16];
+	};
+
+	template<typename T> T make_value(std::size_t i);
+	template<> int make_value<int>(std::size_t i) {return (int)i;}
+	template<> pod64 make_value<pod64>(std::size_t i) {pod64 p; for(int n=0; n<16; ++n) p.v[n] = (int)(i+n); return p;}
+	template<> std::string make_value<std::string>(std::size_t i) {return std::string(24, char('a' + i % 26));} // Longer than SSO
+
+	inline std::size_t weight(int v) {return (std::size_t)v;}
+	inline std::size_t weight(const pod64& v) {return (std::size_t)v.v[0];}
+	inline std::size_t weight(const std::string& v) {return v.size();}
+
+	template<typename T> const char* type_name();
+	template<> const char* type_name<int>() {return "int";}
+	template<> const char* type_name<pod64>() {return "pod64";}
+	template<> const char* type_name<std::string>() {return "string";}
+
+	/** Above this size, O(n) front insertions into vectors are not benchmarked. */
+	const std::size_t slow_front_limit = 100000;
+
+	/** Inserts sorted (position, value) pairs one by one, from the last so positions stay valid. */
+	template<class C, typename T>
+	void insert_each(C& c, const std::vector<std::pair<std::size_t, T> >& batch)
+	{
+		for(std::size_t i = batch.size(); i-- > 0; )
+			c.insert(c.begin() + batch[i].first, batch[i].second);
+	}
+
+	/** Per container specifics. */
+	template<class C> struct traits;
+
+	template<typename T> struct traits<container::tape<T> >
+	{
+		typedef container::tape<T> C;
+		static const char* name() {return "tape";}
+		static bool fast_front() {return true;}
+		static bool fast_batch() {return true;}
+		static bool can_reserve() {return true;}
+		static void push_front(C& c, const T& v) {c.push_front(v);}
+		static void reserve(C& c, std::size_t n) {c.reserve(n);}
+		static void pop_back(C& c, std::size_t n) {c.pop_back(n);}
+		template<class Pred> static void erase_if(C& c, Pred pred) {container::erase_if(c, pred);}
+		static void insert_batch(C& c, const std::vector<std::pair<std::size_t, T> >& batch) {c.insert_batch(batch.begin(), batch.end());}
+	};
+
+	template<typename T> struct traits<std::vector<T> >
+	{
+		typedef std::vector<T> C;
+		static const char* name() {return "vector";}
+		static bool fast_front() {return false;}
+		static bool fast_batch() {return false;}
+		static bool can_reserve() {return true;}
+		static void push_front(C& c, const T& v) {c.insert(c.begin(), v);}
+		static void reserve(C& c, std::size_t n) {c.reserve(n);}
+		static void pop_back(C& c, std::size_t n) {c.erase(c.end() - n, c.end());}
+		template<class Pred> static void erase_if(C& c, Pred pred) {c.erase(std::remove_if(c.begin(), c.end(), pred), c.end());}
+		static void insert_batch(C& c, const std::vector<std::pair<std::size_t, T> >& batch) {insert_each(c, batch);}
+	};
+
+	template<typename T> struct traits<std::deque<T> >
+	{
+		typedef std::deque<T> C;
+		static const char* name() {return "deque";}
+		static bool fast_front() {return true;}
+		static bool fast_batch() {return false;}
+		static bool can_reserve() {return false;}
+		static void push_front(C& c, const T& v) {c.push_front(v);}
+		static void reserve(C&, std::size_t) {}
+		static void pop_back(C& c, std::size_t n) {c.erase(c.end() - n, c.end());}
+		template<class Pred> static void erase_if(C& c, Pred pred) {c.erase(std::remove_if(c.begin(), c.end(), pred), c.end());}
+		static void insert_batch(C& c, const std::vector<std::pair<std::size_t, T> >& batch) {insert_each(c, batch);}
+	};
+
+	template<class C>
+	void bench_container(bench::runner& runner)
+	{
+		typedef typename C::value_type T;
+		typedef traits<C> tr;
+		const char* cname = tr::name();
+		const char* tname = type_name<T>();
+		const T val = make_value<T>(42);
+
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+			const bool front = tr::fast_front() || n <= slow_front_limit;
+
+			runner.run("push_back", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont;
+				sw.start();
+				for(std::size_t i = 0; i < n; ++i)
+					cont.push_back(val);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			if(front)
+			runner.run("push_front", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont;
+				sw.start();
+				for(std::size_t i = 0; i < n; ++i)
+					tr::push_front(cont, val);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			if(front)
+			runner.run("mixed_ends", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont;
+				sw.start();
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					if(i & 1)
+						tr::push_front(cont, val);
+					else
+						cont.push_back(val);
+				}
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("insert_middle", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				std::size_t k = n < 64 ? n : 64;
+				sw.items(k);
+				sw.start();
+				for(std::size_t i = 0; i < k; ++i)
+					cont.insert(cont.begin() + cont.size() / 2, val);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			if(tr::fast_batch() || n <= slow_front_limit)
+			runner.run("insert_batch", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				std::size_t k = n < 1000 ? n : 1000;
+				std::vector<std::pair<std::size_t, T> > batch;
+				for(std::size_t i = 0; i < k; ++i)
+					batch.push_back(std::make_pair(n * i / k, val));
+				sw.items(k);
+				sw.start();
+				tr::insert_batch(cont, batch);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("erase_range", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				std::size_t len = n / 100 ? n / 100 : 1;
+				sw.items(10 * len);
+				sw.start();
+				for(std::size_t i = 0; i < 10; ++i)
+				{
+					typename C::iterator first = cont.begin() + (cont.size() - len) / 2;
+					cont.erase(first, first + len);
+				}
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("erase_if", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				std::size_t k = 0;
+				sw.start();
+				// Drop one element out of ten
+				tr::erase_if(cont, [&k](const T&){return ++k % 10 == 0;});
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("assign", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont;
+				sw.start();
+				cont.assign(n, val);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("pop_back_many", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				sw.start();
+				tr::pop_back(cont, n / 2);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("copy", cname, tname, n, [&](bench::stopwatch& sw){
+				C src(n, val);
+				sw.start();
+				C cont(src);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			if(tr::can_reserve())
+			runner.run("reallocation", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				cont.shrink_to_fit();
+				sw.start();
+				tr::reserve(cont, 2 * n);
+				sw.stop();
+				bench::do_not_optimize(cont);
+			});
+
+			runner.run("iterate", cname, tname, n, [&](bench::stopwatch& sw){
+				C cont(n, val);
+				std::size_t sum = 0;
+				sw.start();
+				for(typename C::const_iterator it = cont.begin(); it != cont.end(); ++it)
+					sum += weight(*it);
+				sw.stop();
+				bench::do_not_optimize(sum);
+			});
+		}
+	}
+
+	template<typename T>
+	void bench_type(bench::runner& runner)
+	{
+		bench_container<container::tape<T> >(runner);
+		bench_container<std::vector<T> >(runner);
+		bench_container<std::deque<T> >(runner);
+	}
+}
+
+BENCH_SUITE(tape)
+{
+	bench_type<int>(runner);
+	bench_type<pod64>(runner);
+	bench_type<std::string>(runner);
+}
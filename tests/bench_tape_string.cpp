@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "bench.hpp"
+
+#include "tape_string.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/** Above this size, O(n) front insertions into std::string are not benchmarked. */
+	const std::size_t slow_front_limit = 100000;
+
+	/** Size of the payload of each framed message. */
+	const std::size_t payload_size = 256;
+
+	/** Per string specifics. */
+	template<class S> struct traits;
+
+	template<> struct traits<std::string>
+	{
+		static const char* name() {return "std::string";}
+		static bool fast_front() {return false;}
+		static void prepend(std::string& s, const char* p, std::size_t n) {s.insert(0, p, n);}
+	};
+
+	template<> struct traits<container::tape_string>
+	{
+		static const char* name() {return "tape_string";}
+		static bool fast_front() {return true;}
+		static void prepend(container::tape_string& s, const char* p, std::size_t n) {s.prepend(p, n);}
+	};
+
+	template<class S>
+	void bench_string(bench::runner& runner)
+	{
+		typedef traits<S> tr;
+		const char* sname = tr::name();
+		const char chunk[] = "0123456789abcdef";
+
+		std::vector<std::size_t> counts = runner.counts();
+		for(std::size_t c = 0; c < counts.size(); ++c)
+		{
+			const std::size_t n = counts[c];
+
+			// Append n chunks of 16 characters.
+			runner.run("append", sname, "char", n, [&](bench::stopwatch& sw){
+				sw.start();
+				S s;
+				for(std::size_t i = 0; i < n; ++i)
+					s.append(chunk, 16);
+				bench::do_not_optimize(s);
+				sw.stop();
+			});
+
+			// Prepend n chunks of 16 characters.
+			if(tr::fast_front() || n <= slow_front_limit)
+			{
+				runner.run("prepend", sname, "char", n, [&](bench::stopwatch& sw){
+					sw.start();
+					S s;
+					for(std::size_t i = 0; i < n; ++i)
+						tr::prepend(s, chunk, 16);
+					bench::do_not_optimize(s);
+					sw.stop();
+				});
+			}
+
+			// Frame n messages: payload first, then length field and header are prepended.
+			runner.run("frame", sname, "char", n, [&](bench::stopwatch& sw){
+				std::string payload(payload_size, 'p');
+				std::size_t total = 0;
+				sw.start();
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					S s;
+					s.append(payload.data(), payload.size());
+					char len[16];
+					int l = std::snprintf(len, sizeof(len), "%zu\r\n", (std::size_t)s.size());
+					tr::prepend(s, len, l);
+					tr::prepend(s, "Content-Length: ", 16);
+					tr::prepend(s, "HTTP/1.1 200 OK\r\n", 17);
+					total += s.size();
+					bench::do_not_optimize(s);
+				}
+				sw.stop();
+				bench::do_not_optimize(total);
+			});
+		}
+	}
+}
+
+BENCH_SUITE(tape_string)
+{
+	bench_string<container::tape_string>(runner);
+	bench_string<std::string>(runner);
+}
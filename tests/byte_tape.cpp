@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "byte_tape.hpp"
+
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static std::string content(const container::byte_tape& buffer)
+{
+	return std::string(buffer.begin(), buffer.end());
+}
+
+TEST_CASE( "Byte tape append, prepend and consume", "[tape]" ) {
+	container::byte_tape buffer;
+	CHECK( buffer.empty() );
+
+	buffer.append("payload", 7);
+	buffer.prepend("len:", 4);
+	CHECK( content(buffer) == "len:payload" );
+
+	buffer.consume(4);
+	CHECK( content(buffer) == "payload" );
+	CHECK( buffer.capacity_before() >= 4 );
+
+	buffer.consume(100);
+	CHECK( buffer.empty() );
+	CHECK( buffer.capacity_before() == 0 );
+}
+
+TEST_CASE( "Byte tape moves bytes back instead of reallocating", "[tape]" ) {
+	container::byte_tape buffer;
+	std::vector<char> bytes(1000, 'x');
+	buffer.append(bytes.data(), bytes.size());
+	buffer.consume(900);
+
+	size_t capacity = buffer.capacity();
+	REQUIRE( capacity - buffer.size() >= 500 );
+	buffer.prepare(capacity - buffer.size());
+	CHECK( buffer.capacity() == capacity );
+	CHECK( buffer.capacity_before() == 0 );
+	CHECK( buffer.size() == 100 );
+
+	// Moving 60 bytes is not worth freeing 40 ones.
+	buffer.consume(40);
+	buffer.prepare(buffer.capacity_after() + 10);
+	CHECK( buffer.capacity() != capacity );
+	CHECK( content(buffer) == std::string(60, 'x') );
+}
+
+TEST_CASE( "Byte tape reads and writes pipes", "[tape]" ) {
+	int in[2], out[2];
+	REQUIRE( pipe(in) == 0 );
+	REQUIRE( pipe(out) == 0 );
+
+	container::byte_tape buffer;
+	REQUIRE( write(in[1], "hello ", 6) == 6 );
+	CHECK( buffer.read_from(in[0]) == 6 );
+	REQUIRE( write(in[1], "world", 5) == 5 );
+	CHECK( buffer.read_from(in[0]) == 5 );
+	CHECK( content(buffer) == "hello world" );
+
+	// Partial write consumes written bytes only.
+	CHECK( buffer.write_to(out[1], 6) == 6 );
+	CHECK( content(buffer) == "world" );
+	CHECK( buffer.write_to(out[1]) == 5 );
+	CHECK( buffer.empty() );
+
+	char res[16];
+	CHECK( read(out[0], res, sizeof(res)) == 11 );
+	CHECK( std::string(res, 11) == "hello world" );
+
+	// End of file
+	close(in[1]);
+	CHECK( buffer.read_from(in[0]) == 0 );
+	CHECK( buffer.empty() );
+
+	close(in[0]);
+	close(out[0]);
+	close(out[1]);
+}
+
+TEST_CASE( "Byte tape reads beyond its slack from sockets", "[tape]" ) {
+	int fds[2];
+	REQUIRE( socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0 );
+
+	std::string message;
+	for(int n=0; message.size() < 40000; ++n)
+		message += std::to_string(n) + ",";
+	REQUIRE( write(fds[0], message.data(), message.size()) == (ssize_t)message.size() );
+
+	// Slack is grown for 16 bytes only, the remaining ones are spilled in the extra buffer.
+	container::byte_tape buffer;
+	CHECK( buffer.read_from(fds[1], 16) == (ssize_t)message.size() );
+	CHECK( content(buffer) == message );
+
+	// Echo it back.
+	size_t written = 0;
+	while(!buffer.empty())
+	{
+		ssize_t res = buffer.write_to(fds[1]);
+		REQUIRE( res > 0 );
+		written += res;
+	}
+	CHECK( written == message.size() );
+
+	container::byte_tape echo;
+	while(echo.size() < message.size())
+		REQUIRE( echo.read_from(fds[0]) > 0 );
+	CHECK( content(echo) == message );
+
+	close(fds[0]);
+	close(fds[1]);
+}
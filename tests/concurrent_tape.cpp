@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "concurrent_tape.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "Concurrent tape append and pop", "[tape]" ) {
+	container::concurrent_tape<std::string> tape;
+	CHECK( tape.size() == 0 );
+	CHECK( tape.read().empty() );
+
+	for(int n = 0; n < 100; ++n)
+		tape.push_back(std::to_string(n));
+	tape.emplace_back(3, 'x');
+	tape.pop_front(10);
+	tape.pop_front();
+
+	container::concurrent_tape<std::string>::snapshot snap = tape.read();
+	REQUIRE( snap.size() == 90 );
+	CHECK( snap.front() == "11" );
+	CHECK( snap[88] == "99" );
+	CHECK( snap.back() == "xxx" );
+
+	tape.pop_front(1000);
+	CHECK( tape.size() == 0 );
+	tape.push_back("a");
+	tape.clear();
+	CHECK( tape.size() == 0 );
+}
+
+TEST_CASE( "Concurrent tape snapshots are immutable", "[tape]" ) {
+	container::concurrent_tape<int> tape;
+	for(int n = 0; n < 10; ++n)
+		tape.push_back(n);
+
+	container::concurrent_tape<int>::snapshot snap = tape.read();
+	for(int n = 10; n < 1000; ++n)
+		tape.push_back(n);
+	tape.pop_front(500);
+
+	REQUIRE( snap.size() == 10 );
+	for(int n = 0; n < 10; ++n)
+		CHECK( snap[n] == n );
+
+	container::concurrent_tape<int>::snapshot other = tape.read();
+	REQUIRE( other.size() == 500 );
+	CHECK( other.front() == 500 );
+	CHECK( other.back() == 999 );
+}
+
+TEST_CASE( "Concurrent tape reclaims buffers after snapshots", "[tape]" ) {
+	container::concurrent_tape<int> tape;
+	tape.push_back(1);
+	container::concurrent_tape<int>::snapshot snap = tape.read();
+
+	tape.reserve(1000);
+	tape.reserve(10000);
+	CHECK( tape.reclaim() == 2 );
+	CHECK( snap.front() == 1 );
+
+	snap.release();
+	CHECK( snap.empty() );
+	CHECK( tape.reclaim() == 0 );
+
+	// Snapshots taken after a growth do not hold previous buffers
+	container::concurrent_tape<int>::snapshot recent = tape.read();
+	tape.reserve(100000);
+	CHECK( tape.reclaim() == 1 );
+	recent = container::concurrent_tape<int>::snapshot();
+	CHECK( tape.reclaim() == 0 );
+}
+
+TEST_CASE( "Concurrent tape readers with a writer", "[tape]" ) {
+	const int count = 200000;
+	container::concurrent_tape<int> tape;
+	std::atomic<bool> done(false);
+	std::atomic<int> errors(0);
+
+	std::vector<std::thread> readers;
+	for(int r = 0; r < 3; ++r)
+	{
+		readers.push_back(std::thread([&](){
+			std::size_t previous = 0;
+			while(!done.load())
+			{
+				container::concurrent_tape<int>::snapshot snap = tape.read();
+				// Consecutive values, the writer popping from the front by chunks of 100
+				if(!snap.empty() && (snap.front() % 100 != 0 || snap.back() - snap.front() + 1 != (int)snap.size()))
+					++errors;
+				for(std::size_t i = 1; i < snap.size(); ++i)
+					if(snap[i] != snap[i-1] + 1)
+						++errors;
+				if(!snap.empty() && (std::size_t)snap.back() < previous)
+					++errors;
+				if(!snap.empty())
+					previous = snap.back();
+			}
+		}));
+	}
+
+	for(int n = 0; n < count; ++n)
+	{
+		tape.push_back(n);
+		if(n % 1000 == 999)
+			tape.pop_front(tape.read().size() > 5000 ? 1000 : 100);
+	}
+	done = true;
+	for(std::size_t r = 0; r < readers.size(); ++r)
+		readers[r].join();
+
+	CHECK( errors.load() == 0 );
+	CHECK( tape.read().back() == count - 1 );
+	CHECK( tape.reclaim() == 0 );
+}
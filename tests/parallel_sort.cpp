@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "parallel_sort.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+TEST_CASE( "Parallel sort of integers", "[tape]" ) {
+	std::mt19937 rng(42);
+	for(std::size_t n : {0, 1, 100, 10000, 100000, 250001})
+	{
+		for(unsigned threads : {1u, 2u, 3u, 8u, 0u})
+		{
+			container::tape<int> tape;
+			for(std::size_t i = 0; i < n; ++i)
+				tape.push_back((int)(rng() % 1000));
+			std::vector<int> ref(tape.begin(), tape.end());
+			std::sort(ref.begin(), ref.end());
+
+			container::parallel_sort(tape, threads);
+			REQUIRE( tape.size() == n );
+			CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+		}
+	}
+}
+
+TEST_CASE( "Parallel sort with comparator", "[tape]" ) {
+	std::mt19937 rng(7);
+	container::tape<int> tape;
+	for(std::size_t i = 0; i < 50000; ++i)
+		tape.push_back((int)rng());
+
+	container::parallel_sort(tape, std::greater<int>(), 4);
+	CHECK( std::is_sorted(tape.begin(), tape.end(), std::greater<int>()) );
+}
+
+TEST_CASE( "Parallel sort of non trivial elements", "[tape]" ) {
+	std::mt19937 rng(3);
+	container::tape<std::string> tape;
+	for(std::size_t i = 0; i < 30000; ++i)
+		tape.push_back(std::string(rng() % 40, 'a') + std::to_string(rng()));
+	std::vector<std::string> ref(tape.begin(), tape.end());
+	std::sort(ref.begin(), ref.end());
+
+	container::parallel_sort(tape, [](const std::string& a, const std::string& b){return a.size() < b.size() || (a.size() == b.size() && a < b);}, 5);
+	std::sort(ref.begin(), ref.end(), [](const std::string& a, const std::string& b){return a.size() < b.size() || (a.size() == b.size() && a < b);});
+	CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+}
+
+TEST_CASE( "Parallel sort rethrows comparator exceptions", "[tape]" ) {
+	container::tape<int> tape;
+	for(int n = 0; n < 20000; ++n)
+		tape.push_back(20000 - n);
+
+	CHECK_THROWS_AS( container::parallel_sort(tape, [](int a, int b){
+		if(a == 1 || b == 1)
+			throw std::runtime_error("compare");
+		return a < b;
+	}, 4), std::runtime_error );
+	CHECK( tape.size() == (size_t)20000 );
+}
+
+TEST_CASE( "Parallel sort rethrows comparator exceptions while merging", "[tape]" ) {
+	// Two chunks, of even and odd numbers, whose first merge throws in its second half
+	const std::string prefix(32, 'n');
+	container::tape<std::string> tape;
+	for(int n = 0; n < 10000; ++n)
+		tape.push_back(prefix + std::to_string(100000 + 2 * (9999 - n)));
+	for(int n = 0; n < 10000; ++n)
+		tape.push_back(prefix + std::to_string(100000 + 2 * n + 1));
+	const std::string x = prefix + "114000", y = prefix + "114001";
+
+	CHECK_THROWS_AS( container::parallel_sort(tape, [&](const std::string& a, const std::string& b){
+		if((a == x && b == y) || (a == y && b == x))
+			throw std::runtime_error("compare");
+		return a < b;
+	}, 2), std::runtime_error );
+	CHECK( tape.size() == (size_t)20000 );
+}
+
+#if defined(__linux__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+TEST_CASE( "Parallel sort runs in the calling thread when threads cannot start", "[tape]" ) {
+	container::tape<int> tape;
+	for(int n = 0; n < 4 * (int)container::parallel::min_chunk; ++n)
+		tape.push_back((n * 7919) % 1000);
+	std::vector<int> ref(tape.begin(), tape.end());
+	std::sort(ref.begin(), ref.end());
+
+	// Limit the address space a little above its current size, so thread stacks cannot be mapped
+	std::size_t pages = 0;
+	std::ifstream("/proc/self/statm") >> pages;
+	rlimit old;
+	REQUIRE( getrlimit(RLIMIT_AS, &old) == 0 );
+	rlimit limit = old;
+	limit.rlim_cur = pages * (std::size_t)sysconf(_SC_PAGESIZE) + (4 << 20);
+	if(old.rlim_cur != RLIM_INFINITY && old.rlim_cur < limit.rlim_cur)
+		limit.rlim_cur = old.rlim_cur;
+
+	std::vector<int> calls(8, 0);
+	bool thrown = false;
+	setrlimit(RLIMIT_AS, &limit);
+	try
+	{
+		container::parallel::run(calls.size(), [&](std::size_t i){++calls[i];});
+		container::parallel_sort(tape, 4u);
+	}
+	catch(...)
+	{
+		thrown = true;
+	}
+	setrlimit(RLIMIT_AS, &old);
+
+	CHECK_FALSE( thrown );
+	CHECK( calls == std::vector<int>(8, 1) );
+	CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+}
+#endif
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+template<typename T, typename Gen>
+static container::tape<T> random_tape(std::size_t n, Gen gen)
+{
+	std::mt19937_64 rng(42);
+	container::tape<T> res;
+	for(std::size_t i = 0; i < n; ++i)
+		res.push_back(gen(rng));
+	return res;
+}
+
+template<typename T>
+static bool sorted_like_std(container::tape<T>& tape)
+{
+	std::vector<T> ref(tape.begin(), tape.end());
+	std::sort(ref.begin(), ref.end());
+	container::radix_sort(tape);
+	return std::equal(ref.begin(), ref.end(), tape.begin());
+}
+
+TEST_CASE( "Radix sort of integers", "[tape]" ) {
+	for(std::size_t n : {0, 1, 10, 1000, 100000})
+	{
+		container::tape<std::uint32_t> u = random_tape<std::uint32_t>(n, [](std::mt19937_64& r){return (std::uint32_t)r();});
+		CHECK( sorted_like_std(u) );
+
+		container::tape<int> i = random_tape<int>(n, [](std::mt19937_64& r){return (int)(r() % 2001) - 1000;});
+		CHECK( sorted_like_std(i) );
+
+		container::tape<std::int64_t> l = random_tape<std::int64_t>(n, [](std::mt19937_64& r){return (std::int64_t)r();});
+		CHECK( sorted_like_std(l) );
+	}
+}
+
+TEST_CASE( "Radix sort of floating point numbers", "[tape]" ) {
+	container::tape<double> d = random_tape<double>(10000, [](std::mt19937_64& r){return ((double)r() / 1e18) - 9.0;});
+	d.push_back(std::numeric_limits<double>::infinity());
+	d.push_back(-std::numeric_limits<double>::infinity());
+	d.push_back(0.0);
+	d.push_back(std::numeric_limits<double>::denorm_min());
+	d.push_back(-std::numeric_limits<double>::max());
+	CHECK( sorted_like_std(d) );
+	CHECK( d.front() == -std::numeric_limits<double>::infinity() );
+	CHECK( d.back() == std::numeric_limits<double>::infinity() );
+
+	container::tape<float> f = random_tape<float>(1000, [](std::mt19937_64& r){return (float)((double)(std::int64_t)r() / 1e15);});
+	CHECK( sorted_like_std(f) );
+}
+
+namespace
+{
+	struct record
+	{
+		std::uint16_t key;
+		std::uint32_t order;
+	};
+}
+
+TEST_CASE( "Radix sort of records is stable", "[tape]" ) {
+	container::tape<record> records;
+	std::mt19937 rng(7);
+	for(std::uint32_t n = 0; n < 5000; ++n)
+	{
+		record r = {(std::uint16_t)(rng() % 100), n};
+		records.push_back(r);
+	}
+
+	container::radix_sort(records, [](const record& r){return r.key;});
+	bool sorted = true;
+	for(std::size_t n = 1; n < records.size(); ++n)
+		sorted = sorted && (records[n-1].key < records[n].key
+			|| (records[n-1].key == records[n].key && records[n-1].order < records[n].order));
+	CHECK( sorted );
+}
+
+namespace
+{
+	std::size_t allocations = 0;
+
+	template<typename T>
+	struct counted_allocator : public std::allocator<T>
+	{
+		typedef T value_type;
+		template<typename U> struct rebind {typedef counted_allocator<U> other;};
+
+		counted_allocator() {}
+		template<typename U> counted_allocator(const counted_allocator<U>&) {}
+
+		T* allocate(std::size_t n, const void* = nullptr)
+		{
+			++allocations;
+			return std::allocator<T>::allocate(n);
+		}
+	};
+}
+
+TEST_CASE( "Radix sort uses the tape slack as buffer", "[tape]" ) {
+	typedef container::tape<std::uint32_t, counted_allocator<std::uint32_t> > counted_tape;
+	for(int side = 0; side < 3; ++side)
+	{
+		counted_tape tape;
+		if(side == 0)
+			tape.reserve(1000, 1000);
+		else if(side == 1)
+			tape.reserve(0, 2000);
+		for(std::uint32_t n = 0; n < 1000; ++n)
+			tape.push_back(n * 2654435761u);
+		if(side == 2)
+			tape.shrink_to_fit();
+
+		allocations = 0;
+		container::radix_sort(tape);
+		CHECK( std::is_sorted(tape.begin(), tape.end()) );
+		// Without slack, a scratch tape is allocated.
+		CHECK( allocations == (side == 2 ? 1 : 0) );
+	}
+}
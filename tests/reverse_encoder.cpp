@@ -0,0 +1,77 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "reverse_encoder.hpp"
+
+#include <vector>
+
+static std::vector<int> bytes(const container::reverse_encoder& enc)
+{
+	return std::vector<int>(enc.data(), enc.data() + enc.size());
+}
+
+TEST_CASE( "Reverse encoder varints", "[tape]" ) {
+	container::reverse_encoder enc;
+	enc.put_varint(150);
+	CHECK( bytes(enc) == std::vector<int>({0x96, 0x01}) );
+
+	enc.clear();
+	enc.put_varint(0);
+	enc.put_varint(127);
+	enc.put_varint(128);
+	CHECK( bytes(enc) == std::vector<int>({0x80, 0x01, 0x7F, 0x00}) );
+
+	enc.clear();
+	enc.put_varint(~(std::uint64_t)0);
+	CHECK( enc.size() == container::reverse_encoder::max_varint_size );
+
+	enc.clear();
+	enc.put_svarint(-1);
+	enc.put_svarint(1);
+	enc.put_fixed32(0x01020304);
+	CHECK( bytes(enc) == std::vector<int>({0x04, 0x03, 0x02, 0x01, 0x02, 0x01}) );
+}
+
+TEST_CASE( "Reverse encoder nested protobuf messages", "[tape]" ) {
+	// message Test1 {int32 a = 1;}
+	// message Test3 {string b = 2; Test1 c = 3;}
+	container::reverse_encoder enc;
+	enc.put_message_field(3, [](container::reverse_encoder& e){
+		e.put_varint_field(1, 150);
+	});
+	enc.put_bytes_field(2, "testing", 7);
+
+	CHECK( bytes(enc) == std::vector<int>({
+		0x12, 0x07, 0x74, 0x65, 0x73, 0x74, 0x69, 0x6e, 0x67,
+		0x1a, 0x03, 0x08, 0x96, 0x01}) );
+
+	container::reverse_encoder::tape_type res = enc.release();
+	CHECK( res.size() == (size_t)14 );
+	CHECK( enc.size() == (size_t)0 );
+}
+
+TEST_CASE( "Reverse encoder DER lengths", "[tape]" ) {
+	container::reverse_encoder enc;
+	std::vector<std::uint8_t> content(300, 0xAB);
+
+	enc.put_bytes(content.data(), 100);
+	enc.put_der_length(0);
+	enc.put_byte(0x04);
+	CHECK( enc.size() == (size_t)102 );
+	CHECK( enc.data()[1] == 100 );
+
+	enc.clear();
+	size_t end = enc.mark();
+	enc.put_bytes(content.data(), 300);
+	enc.put_der_length(end);
+	enc.put_byte(0x04);
+	CHECK( std::vector<int>(enc.data(), enc.data() + 5) == std::vector<int>({0x04, 0x82, 0x01, 0x2C, 0xAB}) );
+	CHECK( enc.size() == (size_t)304 );
+}
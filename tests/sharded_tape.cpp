@@ -0,0 +1,170 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "sharded_tape.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "Sharded tape single thread", "[tape]" ) {
+	container::sharded_tape<int> shards;
+	CHECK( shards.size() == 0 );
+	CHECK( shards.collect().empty() );
+
+	shards.push_back(2);
+	shards.push_back(3);
+	shards.push_front(1);
+	shards.local().push_back(4);
+	CHECK( shards.shards() == 1 );
+	CHECK( shards.size() == 4 );
+
+	container::tape<int> all = shards.collect();
+	CHECK( std::vector<int>(all.begin(), all.end()) == std::vector<int>({1, 2, 3, 4}) );
+	CHECK( shards.size() == 0 );
+
+	// Shards can be filled again after collection
+	shards.push_back(5);
+	all = shards.collect();
+	REQUIRE( all.size() == 1 );
+	CHECK( all[0] == 5 );
+}
+
+TEST_CASE( "Sharded tape concatenates thread shards", "[tape]" ) {
+	const int producers = 4, count = 20000;
+	container::sharded_tape<std::string> shards;
+	std::vector<std::thread> threads;
+	for(int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread([&shards, p](){
+			for(int n = 0; n < count; ++n)
+				shards.emplace_back(std::to_string(p * count + n));
+		}));
+	}
+	for(std::size_t p = 0; p < threads.size(); ++p)
+		threads[p].join();
+	CHECK( shards.shards() == (std::size_t)producers );
+
+	container::tape<std::string> all = shards.collect(3);
+	REQUIRE( all.size() == (std::size_t)(producers * count) );
+	// Each shard is kept in order, as a contiguous run
+	for(std::size_t i = 0; i < all.size(); i += count)
+	{
+		int base = std::stoi(all[i]);
+		CHECK( base % count == 0 );
+		for(int n = 0; n < count; ++n)
+			if(std::stoi(all[i + n]) != base + n)
+				FAIL( "shard not contiguous at " << i + n );
+	}
+}
+
+TEST_CASE( "Sharded tape preserves push order", "[tape]" ) {
+	const int producers = 3, count = 30000;
+	container::sharded_tape<int> shards(true);
+	CHECK( shards.ordered() );
+
+	// Pushes of all threads are serialized, so the collected order is known
+	std::mutex mutex;
+	int next = 0;
+	std::vector<std::thread> threads;
+	for(int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread([&](){
+			for(int n = 0; n < count; ++n)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if(next % 2)
+					shards.push_front(next++);
+				else
+					shards.push_back(next++);
+			}
+		}));
+	}
+	for(std::size_t p = 0; p < threads.size(); ++p)
+		threads[p].join();
+
+	container::tape<int> all = shards.collect(4);
+	REQUIRE( all.size() == (std::size_t)(producers * count) );
+	for(int n = 0; n < producers * count; ++n)
+		if(all[n] != n)
+			FAIL( "unordered at " << n );
+}
+
+TEST_CASE( "Sharded tape does not give shards when order is preserved", "[tape]" ) {
+	container::sharded_tape<int> shards(true);
+	shards.push_back(1);
+	CHECK_THROWS_AS( shards.local(), std::logic_error );
+	shards.push_back(2);
+
+	container::tape<int> all = shards.collect();
+	CHECK( std::vector<int>(all.begin(), all.end()) == std::vector<int>({1, 2}) );
+}
+
+/** Record without default constructor, whose moves throw once a countdown reaches zero. */
+struct collected_record
+{
+	static int countdown;
+	std::string value;
+
+	explicit collected_record(int n):value("collected record " + std::to_string(n)) {}
+	collected_record(const collected_record&) = default;
+	collected_record(collected_record&& r):value(std::move(r.value)) {if(countdown-- == 0) throw std::runtime_error("move");}
+	collected_record& operator=(const collected_record&) = default;
+	collected_record& operator=(collected_record&&) = default;
+};
+int collected_record::countdown = -1;
+
+/** Allocator counting its allocations, of elements or tags. */
+template<typename T>
+struct counting_shard_allocator : std::allocator<T>
+{
+	template<typename U> struct rebind { typedef counting_shard_allocator<U> other; };
+
+	int* allocations;
+
+	explicit counting_shard_allocator(int* allocations):allocations(allocations) {}
+	template<typename U> counting_shard_allocator(const counting_shard_allocator<U>& a):allocations(a.allocations) {}
+
+	T* allocate(std::size_t n) {++*allocations; return std::allocator<T>::allocate(n);}
+};
+
+TEST_CASE( "Sharded tape collects elements without default constructor", "[tape]" ) {
+	int unordered = 0, ordered = 0;
+	for(bool order : {false, true})
+	{
+		int& allocations = order ? ordered : unordered;
+		container::sharded_tape<collected_record, counting_shard_allocator<collected_record> > shards(order, counting_shard_allocator<collected_record>(&allocations));
+		for(int n = 0; n < 100; ++n)
+			shards.emplace_back(n);
+
+		container::tape<collected_record, counting_shard_allocator<collected_record> > all = shards.collect(2);
+		REQUIRE( all.size() == (std::size_t)100 );
+		for(int n = 0; n < 100; ++n)
+			CHECK( all[n].value == "collected record " + std::to_string(n) );
+	}
+	// Tags are allocated by the allocator of the sharded tape
+	CHECK( ordered > unordered );
+}
+
+TEST_CASE( "Sharded tape destroys collected elements when a move throws", "[tape]" ) {
+	for(bool order : {false, true})
+	{
+		container::sharded_tape<collected_record> shards(order);
+		for(int n = 0; n < 100; ++n)
+			shards.emplace_back(n);
+		collected_record::countdown = 50;
+		CHECK_THROWS_AS( shards.collect(), std::runtime_error );
+		collected_record::countdown = -1;
+		CHECK( shards.size() == (std::size_t)100 );
+	}
+}
@@ -10,8 +10,16 @@
 
 #include "tape.hpp"
 
+#include <algorithm>
+#include <array>
 #include <list>
+#include <new>
+#include <random>
 #include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <stdexcept>
 
 TEST_CASE( "Tape default construction", "[tape]" ) {
 	container::tape<int> tape;
@@ -190,7 +198,31 @@ TEST_CASE( "Tape iterator end", "[tape]" ) {
 	CHECK( *--cit == source[9] );
 
 	CHECK( *--rit == source[0] );
-	CHECK( *--crit == source[0] );	
+	CHECK( *--crit == source[0] );
+}
+
+TEST_CASE( "Tape iterator member access", "[tape]" ) {
+	container::tape<std::string> tape;
+	tape.push_back("abc");
+	tape.push_back("de");
+
+	container::tape<std::string>::iterator it = tape.begin();
+	container::tape<std::string>::const_iterator cit = tape.cbegin() + 1;
+	CHECK( it->size() == (size_t)3 );
+	CHECK( cit->size() == (size_t)2 );
+	it->append("x");
+	CHECK( tape.front() == "abcx" );
+
+	static_assert(std::is_same<container::tape<std::string>::const_iterator::reference, const std::string&>::value, "const iterator gives read-only access");
+	static_assert(std::is_same<std::iterator_traits<container::tape<std::string>::const_iterator>::value_type, std::string>::value, "const iterator value type is not const");
+
+#ifdef CONTAINER_TAPE_HAS_CONTIGUOUS_ITERATOR
+	static_assert(std::contiguous_iterator<container::tape<int>::iterator>, "tape iterator is contiguous");
+	static_assert(std::contiguous_iterator<container::tape<int>::const_iterator>, "tape const iterator is contiguous");
+	CHECK( std::to_address(it) == tape.data() );
+	CHECK( std::to_address(cit) == tape.data() + 1 );
+	CHECK( std::to_address(tape.end()) == tape.data() + 2 );
+#endif
 }
 
 
@@ -231,8 +263,8 @@ TEST_CASE( "Tape resize", "[tape]" ) {
 
 }
 
-template<typename T>
-static bool verify_capacity(const container::tape<T>& tape)
+template<typename T, typename Allocator, typename Stats, typename Shrink>
+static bool verify_capacity(const container::tape<T, Allocator, Stats, Shrink>& tape)
 {
 	return tape.capacity() == tape.size() + tape.capacity_before() + tape.capacity_after();
 }
@@ -301,7 +333,7 @@ TEST_CASE( "Tape shrink to fit", "[tape]" ) {
 
 TEST_CASE( "Tape front", "[tape]" ) {
 	int source[] = {2, 3, 4, 5, 6, 7, 8, 9};
-	container::tape<int> tape(source, source+10);
+	container::tape<int> tape(source, source+8);
 
 	CHECK( tape.front() == source[0] );
 }
@@ -937,3 +969,1048 @@ TEST_CASE( "Tape clear", "[tape]" ) {
 	tape.clear();
 	CHECK( tape.empty() );	
 }
+
+typedef container::tape<int, std::allocator<int>, container::tape_stats> stats_tape;
+typedef container::tape<int, std::allocator<int>, container::tape_no_stats, container::tape_shrink_policy> shrink_tape;
+
+TEST_CASE( "Tape stats default", "[tape]" ) {
+	stats_tape tape;
+
+	CHECK( tape.stats().allocations == 0 );
+	CHECK( tape.stats().allocated_bytes == 0 );
+	CHECK( tape.stats().reallocations == 0 );
+	CHECK( tape.stats().moved_elements == 0 );
+	CHECK( tape.stats().peak_capacity == 0 );
+}
+
+TEST_CASE( "Tape stats reallocation", "[tape]" ) {
+	int source[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	stats_tape tape(source, source+10);
+
+	CHECK( tape.stats().allocations == 1 );
+	CHECK( tape.stats().reallocations == 0 );
+	CHECK( tape.stats().allocated_bytes == tape.capacity() * sizeof(int) );
+
+	tape.reserve(100, 100);
+
+	CHECK( tape.stats().allocations == 2 );
+	CHECK( tape.stats().reallocations == 1 );
+	CHECK( tape.stats().moved_elements == 10 );
+	CHECK( tape.stats().peak_capacity == tape.capacity() );
+	CHECK( tape.stats().peak_capacity_before >= 100 );
+	CHECK( tape.stats().peak_capacity_after >= 100 );
+
+	tape.shrink_to_fit();
+
+	CHECK( tape.stats().reallocations == 2 );
+	CHECK( tape.stats().moved_elements == 20 );
+	CHECK( tape.stats().peak_capacity == 210 );
+}
+
+TEST_CASE( "Tape stats slack", "[tape]" ) {
+	int source[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	stats_tape tape(source, source+10);
+	tape.shrink_to_fit();
+	tape.stats().reset();
+
+	tape.pop_front(3);
+	tape.pop_back(2);
+
+	CHECK( tape.stats().peak_capacity_before == 3 );
+	CHECK( tape.stats().peak_capacity_after == 2 );
+	CHECK( tape.stats().reallocations == 0 );
+}
+
+TEST_CASE( "Tape stats are not transferred", "[tape]" ) {
+	int source[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	stats_tape tape1(source, source+10);
+	stats_tape tape2(std::move(tape1));
+
+	CHECK( tape1.stats().allocations == 1 );
+	CHECK( tape2.stats().allocations == 0 );
+}
+
+template<typename T, bool Propagate>
+struct counting_allocator
+{
+	typedef T value_type;
+	typedef std::integral_constant<bool, Propagate> propagate_on_container_copy_assignment;
+	typedef std::integral_constant<bool, Propagate> propagate_on_container_move_assignment;
+	typedef std::integral_constant<bool, Propagate> propagate_on_container_swap;
+	template<typename U> struct rebind { typedef counting_allocator<U, Propagate> other; };
+
+	int   id;
+	long* live; // Number of elements currently allocated with this allocator
+
+	counting_allocator(int id, long* live):id(id), live(live) {}
+	template<typename U> counting_allocator(const counting_allocator<U, Propagate>& a):id(a.id), live(a.live) {}
+
+	T* allocate(size_t n) {*live += n; return static_cast<T*>(::operator new(n * sizeof(T)));}
+	void deallocate(T* p, size_t n) {*live -= n; ::operator delete(p);}
+
+	bool operator==(const counting_allocator& a) const {return id == a.id;}
+	bool operator!=(const counting_allocator& a) const {return id != a.id;}
+};
+
+TEST_CASE( "Tape move assignement releases previous memory", "[tape]" ) {
+	int source[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	long live = 0;
+	{
+		counting_allocator<int, false> alloc(1, &live);
+		container::tape<int, counting_allocator<int, false> > tape1(source, source+10, alloc);
+		container::tape<int, counting_allocator<int, false> > tape2(source, source+5, alloc);
+		long before = live;
+
+		tape2 = std::move(tape1);
+
+		CHECK( live == before - 15 );
+		CHECK( tape2.size() == 10 );
+		CHECK( tape1.size() == 0 );
+	}
+	CHECK( live == 0 );
+}
+
+TEST_CASE( "Tape move assignement with unequal allocators", "[tape]" ) {
+	int source[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	long live1 = 0, live2 = 0;
+	{
+		container::tape<int, counting_allocator<int, false> > tape1(source, source+10, counting_allocator<int, false>(1, &live1));
+		container::tape<int, counting_allocator<int, false> > tape2(counting_allocator<int, false>(2, &live2));
+
+		tape2 = std::move(tape1);
+
+		// Allocator is not propagated, elements are moved in memory of tape2 allocator.
+		CHECK( tape2.get_allocator().id == 2 );
+		CHECK( live2 >= 10 );
+		CHECK( tape1.size() == 0 );
+		CHECK( tape2.size() == 10 );
+		for(size_t n=0; n<tape2.size(); ++n)
+			CHECK( tape2[n] == source[n] );
+	}
+	CHECK( live1 == 0 );
+	CHECK( live2 == 0 );
+}
+
+TEST_CASE( "Tape assignement with propagating allocators", "[tape]" ) {
+	int source[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	long live1 = 0, live2 = 0;
+	{
+		container::tape<int, counting_allocator<int, true> > tape1(source, source+10, counting_allocator<int, true>(1, &live1));
+		container::tape<int, counting_allocator<int, true> > tape2(source, source+5, counting_allocator<int, true>(2, &live2));
+
+		// Copy
+		tape2 = tape1;
+		CHECK( tape2.get_allocator().id == 1 );
+		CHECK( live2 == 0 );
+
+		// Move
+		container::tape<int, counting_allocator<int, true> > tape3(source, source+5, counting_allocator<int, true>(3, &live2));
+		tape3 = std::move(tape1);
+		CHECK( tape3.get_allocator().id == 1 );
+		CHECK( live2 == 0 );
+		CHECK( tape3.size() == 10 );
+
+		// Swap
+		container::tape<int, counting_allocator<int, true> > tape4(source, source+5, counting_allocator<int, true>(4, &live2));
+		tape4.swap(tape3);
+		CHECK( tape4.get_allocator().id == 1 );
+		CHECK( tape3.get_allocator().id == 4 );
+		CHECK( tape4.size() == 10 );
+		CHECK( tape3.size() == 5 );
+	}
+	CHECK( live1 == 0 );
+	CHECK( live2 == 0 );
+}
+
+TEST_CASE( "Tape copy and move empty", "[tape]" ) {
+	container::tape<int> tape1;
+	container::tape<int> tape2(tape1);
+	container::tape<int> tape3(std::move(tape1), std::allocator<int>());
+
+	CHECK( tape2.empty() );
+	CHECK( tape3.empty() );
+
+	tape2 = tape3;
+	CHECK( tape2.empty() );
+}
+
+#ifdef CONTAINER_TAPE_HAS_PMR
+TEST_CASE( "Tape pmr", "[tape][pmr]" ) {
+	char buffer[4096];
+	std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	container::pmr::tape<int> tape(&resource);
+	for(int n=0; n<10; ++n)
+		tape.push_back(n);
+
+	CHECK( tape.size() == 10 );
+	CHECK( (char*)tape.data() >= buffer );
+	CHECK( (char*)tape.data() < buffer + sizeof(buffer) );
+
+	// Copy gets default resource
+	container::pmr::tape<int> copy(tape);
+	CHECK( copy.get_allocator().resource() == std::pmr::get_default_resource() );
+	CHECK( copy.size() == 10 );
+
+	// Move with same resource takes storage over
+	const int* data = tape.data();
+	container::pmr::tape<int> moved(std::move(tape), &resource);
+	CHECK( moved.data() == data );
+
+	// Move with another resource moves elements
+	std::pmr::unsynchronized_pool_resource pool;
+	container::pmr::tape<int> other(&pool);
+	other = std::move(moved);
+	CHECK( other.get_allocator().resource() == &pool );
+	CHECK( other.data() != data );
+	CHECK( other.size() == 10 );
+	for(int n=0; n<10; ++n)
+		CHECK( other[n] == n );
+}
+
+TEST_CASE( "Tape pmr copy keeps shrink policy", "[tape][pmr]" ) {
+	typedef container::pmr::tape<int, container::tape_no_stats, container::tape_shrink_policy> pmr_shrink_tape;
+	pmr_shrink_tape tape;
+	tape.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+	tape.push_back(42, (size_t)10);
+
+	std::pmr::unsynchronized_pool_resource pool;
+	pmr_shrink_tape copy(tape, &pool);
+	CHECK( copy.get_shrink_policy().slides() );
+	CHECK( copy.size() == 10 );
+}
+#endif
+
+TEST_CASE( "Tape shrink policy disabled by default", "[tape]" ) {
+	container::tape<int> tape;
+	CHECK( !tape.get_shrink_policy().enabled() );
+	CHECK( !tape.get_shrink_policy().slides() );
+	CHECK( sizeof(tape) < sizeof(shrink_tape) );
+	tape.push_back(42, (size_t)1000);
+	size_t capacity = tape.capacity();
+
+	tape.pop_back(990);
+	CHECK( tape.capacity() == capacity );
+	CHECK( !tape.maybe_shrink() );
+	CHECK( tape.capacity() == capacity );
+}
+
+TEST_CASE( "Tape shrink policy", "[tape]" ) {
+	shrink_tape tape;
+	tape.set_shrink_policy(container::tape_shrink_policy(0.25f, 2.0f));
+	for(int n=0; n<1000; ++n)
+		tape.push_back(n);
+	size_t capacity = tape.capacity();
+
+	// Above threshold, nothing happen
+	tape.pop_front(500);
+	CHECK( tape.capacity() == capacity );
+
+	// Below threshold, shrink on both sides, keeping slack where tape grew
+	tape.pop_back(260);
+	CHECK( tape.size() == 240 );
+	CHECK( tape.capacity() == 480 );
+	CHECK( tape.capacity_before() < tape.capacity_after() );
+	CHECK( verify_capacity(tape) );
+	for(size_t n=0; n<tape.size(); ++n)
+		CHECK( tape[n] == (int)n + 500 );
+
+	// Hysteresis: no new shrink until below threshold again
+	tape.pop_back(100);
+	CHECK( tape.capacity() == 480 );
+	tape.erase(tape.begin(), tape.begin() + 30);
+	CHECK( tape.size() == 110 );
+	CHECK( tape.capacity() == 220 );
+	CHECK( tape.front() == 530 );
+
+	// Clearing releases memory
+	tape.clear();
+	CHECK( tape.capacity() == 0 );
+}
+
+TEST_CASE( "Tape shrink policy minimal capacity", "[tape]" ) {
+	shrink_tape tape;
+	tape.set_shrink_policy(container::tape_shrink_policy(0.25f, 2.0f, 100));
+	tape.push_back(42, (size_t)1000);
+
+	tape.pop_back(999);
+	CHECK( tape.capacity() == 100 );
+	tape.clear();
+	CHECK( tape.capacity() == 100 );
+}
+
+TEST_CASE( "Tape deferred shrink policy", "[tape]" ) {
+	shrink_tape tape;
+	tape.set_shrink_policy(container::tape_shrink_policy(0.25f, 2.0f, 0, true));
+	tape.push_back(42, (size_t)1000);
+	size_t capacity = tape.capacity();
+
+	tape.pop_front(990);
+	CHECK( tape.capacity() == capacity );
+
+	CHECK( tape.maybe_shrink() );
+	CHECK( tape.capacity() == 20 );
+	CHECK( tape.size() == 10 );
+	CHECK( !tape.maybe_shrink() );
+}
+
+TEST_CASE( "Tape sliding window", "[tape]" ) {
+	container::tape<int, std::allocator<int>, container::tape_stats, container::tape_shrink_policy> tape;
+	tape.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+	CHECK( tape.get_shrink_policy().slides() );
+	CHECK( !tape.get_shrink_policy().enabled() );
+
+	// Queue with a window of 1000 elements
+	int next = 0;
+	for(; next < 1000; ++next)
+		tape.push_back(next);
+	size_t reallocations = 0, capacity = 0;
+	for(int round = 0; round < 1000; ++round)
+	{
+		for(int n = 0; n < 100; ++n)
+			tape.push_back(next++);
+		tape.pop_front(100);
+		if(round == 10)
+		{
+			reallocations = tape.stats().reallocations;
+			capacity = tape.capacity();
+		}
+	}
+	// Steady state: no more allocation, elements slide over freed slots
+	CHECK( tape.stats().reallocations == reallocations );
+	CHECK( tape.capacity() == capacity );
+	CHECK( tape.capacity() < 4000 );
+	REQUIRE( tape.size() == 1000 );
+	for(size_t n = 0; n < tape.size(); ++n)
+		CHECK( tape[n] == next - 1000 + (int)n );
+}
+
+TEST_CASE( "Tape sliding window reservations", "[tape]" ) {
+	shrink_tape plain, sliding;
+	sliding.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+	for(int round = 0; round < 1000; ++round)
+	{
+		plain.reserve_after(plain.capacity_after() + 100);
+		plain.push_back(round, (size_t)100);
+		plain.pop_front(100);
+		sliding.reserve_after(sliding.capacity_after() + 100);
+		sliding.push_back(round, (size_t)100);
+		sliding.pop_front(100);
+	}
+	// Freed slots are kept before elements by reservations, unless sliding
+	CHECK( plain.capacity_before() >= 99000 );
+	CHECK( sliding.capacity_before() == 0 );
+	CHECK( sliding.empty() );
+
+	// An emptied sliding tape restarts where it grows, without reallocation
+	sliding.push_back(1, (size_t)10);
+	sliding.pop_front(5);
+	CHECK( sliding.capacity_before() == 5 );
+	sliding.pop_front(5);
+	CHECK( sliding.capacity_before() == 0 );
+}
+
+TEST_CASE( "Tape sliding window both ways", "[tape]" ) {
+	container::tape<std::string, std::allocator<std::string>, container::tape_no_stats, container::tape_shrink_policy> tape;
+	tape.set_shrink_policy(container::tape_shrink_policy::sliding_window(0.25f));
+	for(int n = 0; n < 100; ++n)
+		tape.push_front(std::to_string(n));
+	size_t capacity = tape.capacity();
+	// Reverse queue: push_front and pop_back
+	for(int n = 100; n < 10000; ++n)
+	{
+		tape.push_front(std::to_string(n));
+		tape.pop_back();
+	}
+	CHECK( tape.capacity() <= 2 * capacity );
+	REQUIRE( tape.size() == 100 );
+	CHECK( tape.front() == "9999" );
+	CHECK( tape.back() == "9900" );
+
+	// Pushing an element of the tape which slides
+	while(tape.capacity_before() > 0)
+		tape.push_front(tape.back());
+	tape.push_front(tape.back());
+	CHECK( tape.front() == "9900" );
+}
+
+TEST_CASE( "Tape comparisons", "[tape]" ) {
+	container::tape<int> a{1, 2, 3}, b{1, 2, 3}, c{1, 2, 4}, d{1, 2};
+	CHECK( a == b );
+	CHECK_FALSE( a != b );
+	CHECK( a != c );
+	CHECK( a < c );
+	CHECK( c > a );
+	CHECK( d < a );
+	CHECK( a <= b );
+	CHECK( a >= d );
+	CHECK_FALSE( c <= a );
+}
+
+TEST_CASE( "Tape count and value of integral type", "[tape]" ) {
+	// Range overloads only take iterators
+	container::tape<int> tape(3, 7);
+	CHECK( tape == container::tape<int>({7, 7, 7}) );
+	tape.assign(2, 5);
+	CHECK( tape == container::tape<int>({5, 5}) );
+	tape.push_back(1, 2);
+	tape.push_front(0, 1);
+	tape.insert(tape.begin() + 1, 2, 9);
+	CHECK( tape == container::tape<int>({0, 9, 9, 5, 5, 1, 1}) );
+}
+
+TEST_CASE( "Tape growth is geometric", "[tape]" ) {
+	stats_tape tape;
+	for(int n=0; n<100000; ++n)
+		tape.push_back(n);
+
+	CHECK( tape.size() == 100000 );
+	CHECK( tape.stats().reallocations < 20 );
+	CHECK( tape.capacity() < 2 * 100000 + 64 );
+}
+
+TEST_CASE( "Tape learns append bias", "[tape]" ) {
+	container::tape<int> tape;
+	for(int n=0; n<10000; ++n)
+		tape.push_back(n);
+
+	CHECK( tape.capacity_before() < tape.capacity_after() );
+	CHECK( tape.capacity_before() < tape.size() / 10 );
+
+	// Clearing recenters start according to bias
+	tape.clear();
+	CHECK( tape.capacity_before() < tape.capacity() / 10 );
+}
+
+TEST_CASE( "Tape learns prepend bias", "[tape]" ) {
+	container::tape<int> tape;
+	for(int n=0; n<10000; ++n)
+		tape.push_front(n);
+
+	CHECK( tape.capacity_after() < tape.capacity_before() );
+	CHECK( tape.capacity_after() < tape.size() / 10 );
+	for(size_t n=0; n<tape.size(); ++n)
+		CHECK( tape[n] == 9999 - (int)n );
+}
+
+TEST_CASE( "Tape learns balanced bias", "[tape]" ) {
+	container::tape<int> tape;
+	for(int n=0; n<10000; ++n)
+	{
+		tape.push_front(n);
+		tape.push_back(n);
+	}
+
+	CHECK( tape.capacity_before() > 0 );
+	CHECK( tape.capacity_after() > 0 );
+	CHECK( tape.front() == 9999 );
+	CHECK( tape.back() == 9999 );
+}
+
+TEST_CASE( "Tape learned bias follows content", "[tape]" ) {
+	container::tape<int> appended, fresh;
+	for(int n=0; n<10000; ++n)
+		appended.push_back(n);
+
+	// Copies keep the bias
+	container::tape<int> copy(appended), extended(appended, appended.get_allocator());
+	copy.clear();
+	CHECK( copy.capacity_before() < copy.capacity() / 10 );
+	extended.clear();
+	CHECK( extended.capacity_before() < extended.capacity() / 10 );
+
+	// Swap exchanges the bias with the content
+	fresh.swap(appended);
+	fresh.clear();
+	CHECK( fresh.capacity_before() < fresh.capacity() / 10 );
+}
+
+TEST_CASE( "Tape object size", "[tape]" ) {
+	// Default policies are empty and the growth bias is packed next to the allocator:
+	// a tape is its four pointers and sizes, plus the allocator.
+	CHECK( sizeof(container::tape<int>) <= 4 * sizeof(void*) + 8 );
+}
+
+TEST_CASE( "Tape insert and erase strings", "[tape]" ) {
+	container::tape<std::string> tape;
+	std::vector<std::string> vector;
+
+	std::srand(42);
+	for(int n=0; n<2000; ++n)
+	{
+		std::string str(20 + n % 7, 'a' + n % 26);
+		size_t pos = vector.empty() ? 0 : std::rand() % (vector.size() + 1);
+		switch(std::rand() % 5)
+		{
+		case 0:
+			tape.insert(tape.begin() + pos, str);
+			vector.insert(vector.begin() + pos, str);
+			break;
+		case 1:
+			tape.insert(tape.begin() + pos, (size_t)3, str);
+			vector.insert(vector.begin() + pos, (size_t)3, str);
+			break;
+		case 2:
+			tape.emplace(tape.begin() + pos, 5, 'z');
+			vector.emplace(vector.begin() + pos, 5, 'z');
+			break;
+		case 3:
+			if(pos < vector.size())
+			{
+				tape.erase(tape.begin() + pos);
+				vector.erase(vector.begin() + pos);
+			}
+			break;
+		case 4:
+			if(pos + 2 < vector.size())
+			{
+				tape.erase(tape.begin() + pos, tape.begin() + pos + 3);
+				vector.erase(vector.begin() + pos, vector.begin() + pos + 3);
+			}
+			break;
+		}
+	}
+
+	REQUIRE( tape.size() == vector.size() );
+	for(size_t n=0; n<tape.size(); ++n)
+		CHECK( tape[n] == vector[n] );
+}
+
+TEST_CASE( "Tape insert an element of itself", "[tape]" ) {
+	container::tape<std::string> tape{"a", "b", "c", "d", "e"};
+
+	tape.insert(tape.begin() + 1, tape[3]);
+	tape.insert(tape.begin() + 4, (size_t)2, tape[0]);
+	tape.emplace(tape.begin() + 2, tape.back());
+
+	std::vector<std::string> expected{"a", "d", "e", "b", "c", "a", "a", "d", "e"};
+	REQUIRE( tape.size() == expected.size() );
+	for(size_t n=0; n<tape.size(); ++n)
+		CHECK( tape[n] == expected[n] );
+}
+
+TEST_CASE( "Tape insert an element of itself at both ends without slack", "[tape]" ) {
+	const std::string f = "first string, too long to be short", l = "last string, too long to be short";
+	container::tape<std::string> tape{f, l};
+
+	tape.shrink_to_fit();
+	tape.insert(tape.begin(), tape.back());
+	tape.shrink_to_fit();
+	tape.insert(tape.end(), tape.front());
+	tape.shrink_to_fit();
+	tape.emplace(tape.begin(), tape[1]);
+	tape.shrink_to_fit();
+	tape.emplace_back(tape[1]);
+	tape.shrink_to_fit();
+	tape.push_front(std::move(tape[1]));
+
+	std::vector<std::string> expected{l, f, l, f, l, l, l};
+	REQUIRE( tape.size() == expected.size() );
+	for(size_t n=0; n<tape.size(); ++n)
+		if(n != 2) // Moved from
+			CHECK( tape[n] == expected[n] );
+}
+
+struct copy_counter
+{
+	static int copies;
+	int value;
+
+	copy_counter(int value = 0):value(value) {}
+	copy_counter(const copy_counter& c):value(c.value) {++copies;}
+	copy_counter(copy_counter&& c) noexcept :value(c.value) {}
+	copy_counter& operator=(const copy_counter& c) {value = c.value; ++copies; return *this;}
+	copy_counter& operator=(copy_counter&& c) noexcept {value = c.value; return *this;}
+};
+int copy_counter::copies = 0;
+
+TEST_CASE( "Tape shifts elements by moves", "[tape]" ) {
+	container::tape<copy_counter> tape;
+	for(int n=0; n<100; ++n)
+		tape.emplace_back(n);
+	copy_counter val(-1);
+
+	copy_counter::copies = 0;
+	tape.insert(tape.begin() + 30, val);
+	tape.insert(tape.begin() + 70, val);
+	tape.erase(tape.begin() + 10, tape.begin() + 20);
+	tape.erase(tape.begin() + 80);
+	tape.reserve(1000, 1000);
+
+	CHECK( copy_counter::copies == 2 );
+	CHECK( tape.size() == 91 );
+	CHECK( tape[20].value == -1 );
+	CHECK( tape[60].value == -1 );
+}
+
+TEST_CASE( "Tape uninitialized append and prepend", "[tape]" ) {
+	container::tape<char> tape;
+	tape.push_back('-');
+
+	char* back = tape.grow_back_uninitialized(1000);
+	REQUIRE( tape.capacity_after() >= 1000 );
+	CHECK( tape.size() == 1 );
+	std::memcpy(back, "world", 5);
+	tape.commit_back(5);
+
+	char* front = tape.grow_front_uninitialized(1000);
+	REQUIRE( tape.capacity_before() >= 1000 );
+	std::memcpy(front + 1000 - 5, "hello", 5);
+	tape.commit_front(5);
+
+	CHECK( std::string(tape.begin(), tape.end()) == "hello-world" );
+	void* end = tape.grow_back_uninitialized(10);
+	CHECK( end == (void*)(&tape.front() + tape.size()) );
+	CHECK_THROWS_AS( tape.commit_back(tape.capacity_after() + 1), std::out_of_range );
+	CHECK_THROWS_AS( tape.commit_front(tape.capacity_before() + 1), std::out_of_range );
+	CHECK( tape.size() == 11 );
+}
+
+TEST_CASE( "Tape split moves the shortest side", "[tape]" ) {
+	container::tape<std::string> tape;
+	for(int n=0; n<100; ++n)
+		tape.push_back(std::to_string(n));
+
+	// Short tail is moved out
+	const std::string* data = &tape.front();
+	container::tape<std::string> tail = tape.split(90);
+	CHECK( tape.size() == (size_t)90 );
+	CHECK( &tape.front() == data );
+	REQUIRE( tail.size() == (size_t)10 );
+	CHECK( tail.front() == "90" );
+	CHECK( tail.back() == "99" );
+
+	// Long tail takes the storage over
+	const std::string* third = &tape[30];
+	container::tape<std::string> rest = tape.split(30);
+	CHECK( tape.size() == (size_t)30 );
+	CHECK( tape.back() == "29" );
+	REQUIRE( rest.size() == (size_t)60 );
+	CHECK( &rest.front() == third );
+	CHECK( rest.back() == "89" );
+
+	CHECK( tape.split(30).empty() );
+	CHECK( tape.split(0).size() == (size_t)30 );
+	CHECK( tape.empty() );
+	CHECK_THROWS_AS( tape.split(1), std::out_of_range );
+}
+
+/** Allocator throwing std::bad_alloc once its budget of allocations is spent. */
+template<typename T>
+struct limited_allocator : std::allocator<T>
+{
+	template<typename U> struct rebind { typedef limited_allocator<U> other; };
+
+	int* budget;
+
+	explicit limited_allocator(int* budget):budget(budget) {}
+	template<typename U> limited_allocator(const limited_allocator<U>& a):budget(a.budget) {}
+
+	T* allocate(size_t n) {if(*budget == 0) throw std::bad_alloc(); --*budget; return std::allocator<T>::allocate(n);}
+};
+
+TEST_CASE( "Tape split is unchanged when allocation fails", "[tape]" ) {
+	int budget = -1;
+	container::tape<std::string, limited_allocator<std::string> > tape{limited_allocator<std::string>(&budget)};
+	for(int n=0; n<100; ++n)
+		tape.push_back(std::to_string(n));
+
+	budget = 0;
+	CHECK_THROWS_AS( tape.split(10), std::bad_alloc );
+	CHECK_THROWS_AS( tape.split(90), std::bad_alloc );
+	REQUIRE( tape.size() == (size_t)100 );
+	for(int n=0; n<100; ++n)
+		CHECK( tape[n] == std::to_string(n) );
+
+	budget = 1;
+	CHECK( tape.split(10).size() == (size_t)90 );
+	CHECK( tape.size() == (size_t)10 );
+	CHECK( tape.back() == "9" );
+}
+
+TEST_CASE( "Tape split keeps the shrink policy", "[tape]" ) {
+	for(size_t pos : {10, 90})
+	{
+		shrink_tape tape;
+		tape.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+		for(int n=0; n<100; ++n)
+			tape.push_back(n);
+		shrink_tape rest = tape.split(pos);
+		CHECK( rest.get_shrink_policy().slides() );
+		CHECK( rest.front() == (int)pos );
+	}
+}
+
+TEST_CASE( "Tape append and prepend tapes", "[tape]" ) {
+	container::tape<std::string> big, small;
+	for(int n=0; n<100; ++n)
+		big.push_back(std::to_string(n));
+	small.push_back("a");
+	small.push_back("b");
+
+	// Small tape is moved into the big one's slack
+	const std::string* data = &big.front();
+	big.append(std::move(small));
+	CHECK( big.size() == (size_t)102 );
+	CHECK( &big.front() == data );
+	CHECK( big.back() == "b" );
+	CHECK( small.empty() );
+
+	// Big tape storage is taken over by the small one
+	small.push_back("x");
+	small.append(std::move(big));
+	REQUIRE( small.size() == (size_t)103 );
+	CHECK( &small[1] == data );
+	CHECK( small.front() == "x" );
+	CHECK( small[1] == "0" );
+	CHECK( small.back() == "b" );
+	CHECK( big.empty() );
+
+	big.push_back("y");
+	big.prepend(std::move(small));
+	REQUIRE( big.size() == (size_t)104 );
+	CHECK( big.front() == "x" );
+	CHECK( big.back() == "y" );
+	CHECK( small.empty() );
+
+	small.push_back("z");
+	big.prepend(std::move(small));
+	CHECK( big.size() == (size_t)105 );
+	CHECK( big.front() == "z" );
+	CHECK( big[1] == "x" );
+
+	// Empty tapes
+	container::tape<std::string> empty;
+	empty.append(std::move(big));
+	CHECK( empty.size() == (size_t)105 );
+	empty.prepend(container::tape<std::string>());
+	CHECK( empty.size() == (size_t)105 );
+}
+
+TEST_CASE( "Tape erase if", "[tape]" ) {
+	for(int modulo : {2, 3, 7, 1000})
+	{
+		for(int offset : {0, 1, 5, 900})
+		{
+			container::tape<std::string> tape;
+			std::vector<std::string> ref;
+			for(int n=0; n<1000; ++n)
+			{
+				tape.push_back(std::to_string(n));
+				if((n + offset) % modulo != 0)
+					ref.push_back(std::to_string(n));
+			}
+
+			size_t calls = 0;
+			size_t removed = container::erase_if(tape, [&](const std::string& s){++calls; return (std::stoi(s) + offset) % modulo == 0;});
+			CHECK( calls == (size_t)1000 );
+			CHECK( removed == 1000 - ref.size() );
+			REQUIRE( tape.size() == ref.size() );
+			CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+		}
+	}
+
+	container::tape<int> empty;
+	CHECK( container::erase_if(empty, [](int){return true;}) == (size_t)0 );
+}
+
+TEST_CASE( "Tape erase if moves the shortest side", "[tape]" ) {
+	stats_tape tape;
+	for(int n=0; n<100; ++n)
+		tape.push_back(n);
+
+	// Removed elements near the front: only the 10 first elements are shifted
+	tape.stats().reset();
+	CHECK( container::erase_if(tape, [](int v){return v == 10 || v == 12;}) == (size_t)2 );
+	CHECK( tape.stats().moved_elements == 11 );
+	CHECK( tape.front() == 0 );
+	CHECK( tape[10] == 11 );
+	CHECK( tape[11] == 13 );
+
+	// Removed elements near the back: only the 8 last elements are shifted
+	tape.stats().reset();
+	CHECK( container::erase_if(tape, [](int v){return v == 90 || v == 91;}) == (size_t)2 );
+	CHECK( tape.stats().moved_elements == 8 );
+	CHECK( tape.size() == (size_t)96 );
+	CHECK( tape[87] == 89 );
+	CHECK( tape[88] == 92 );
+	CHECK( tape.back() == 99 );
+}
+
+TEST_CASE( "Tape erase indices", "[tape]" ) {
+	container::tape<std::string> tape;
+	for(int n=0; n<20; ++n)
+		tape.push_back(std::to_string(n));
+
+	std::vector<size_t> front = {1, 3, 3, 4, 8};
+	CHECK( container::erase_indices(tape, front.begin(), front.end()) == (size_t)4 );
+	std::vector<std::string> ref = {"0", "2", "5", "6", "7", "9", "10", "11", "12", "13", "14", "15", "16", "17", "18", "19"};
+	REQUIRE( tape.size() == ref.size() );
+	CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+
+	std::vector<size_t> back = {10, 14, 15};
+	CHECK( container::erase_indices(tape, back.begin(), back.end()) == (size_t)3 );
+	ref = {"0", "2", "5", "6", "7", "9", "10", "11", "12", "13", "15", "16", "17"};
+	REQUIRE( tape.size() == ref.size() );
+	CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+
+	// Invalid positions leave the tape unchanged
+	std::vector<size_t> invalid = {0, 13};
+	CHECK_THROWS_AS( container::erase_indices(tape, invalid.begin(), invalid.end()), std::out_of_range );
+	CHECK( tape.size() == ref.size() );
+	CHECK( container::erase_indices(tape, invalid.begin(), invalid.begin()) == (size_t)0 );
+
+	std::vector<size_t> all;
+	for(size_t n=0; n<tape.size(); ++n)
+		all.push_back(n);
+	CHECK( container::erase_indices(tape, all.begin(), all.end()) == ref.size() );
+	CHECK( tape.empty() );
+}
+
+TEST_CASE( "Tape insert batch", "[tape]" ) {
+	std::mt19937 rng(11);
+	for(int slack = 0; slack < 4; ++slack)
+	{
+		for(size_t count : {1, 5, 50, 500})
+		{
+			container::tape<std::string> tape;
+			if(slack == 1)
+				tape.reserve(600, 600);
+			else if(slack == 2)
+				tape.reserve(0, 1000);
+			else if(slack == 3)
+				tape.reserve(1000, 0);
+			for(int n=0; n<300; ++n)
+				tape.push_back(std::to_string(n));
+			std::vector<std::string> ref(tape.begin(), tape.end());
+
+			std::vector<std::pair<size_t, std::string> > batch;
+			for(size_t n=0; n<count; ++n)
+				batch.push_back(std::make_pair((size_t)(rng() % 301), "i" + std::to_string(n)));
+			std::stable_sort(batch.begin(), batch.end(), [](const std::pair<size_t, std::string>& a, const std::pair<size_t, std::string>& b){return a.first < b.first;});
+			for(size_t n=batch.size(); n-->0; )
+				ref.insert(ref.begin() + batch[n].first, batch[n].second);
+
+			tape.insert_batch(batch.begin(), batch.end());
+			REQUIRE( tape.size() == ref.size() );
+			CHECK( std::equal(ref.begin(), ref.end(), tape.begin()) );
+		}
+	}
+}
+
+TEST_CASE( "Tape insert batch moves elements at most once", "[tape]" ) {
+	stats_tape tape;
+	for(int n=0; n<100; ++n)
+		tape.push_back(n);
+	tape.reserve(10, 10);
+	tape.stats().reset();
+
+	// Elements before position 5 are shifted to front, elements from 95 to back.
+	tape.insert_batch({{2, -1}, {5, -2}, {95, -3}});
+	CHECK( tape.stats().reallocations == 0 );
+	CHECK( tape.stats().moved_elements == 10 );
+	REQUIRE( tape.size() == (size_t)103 );
+	CHECK( tape[2] == -1 );
+	CHECK( tape[6] == -2 );
+	CHECK( tape[97] == -3 );
+	CHECK( tape.back() == 99 );
+
+	// Without enough slack, elements are moved once to new storage.
+	tape.shrink_to_fit();
+	tape.stats().reset();
+	tape.insert_batch({{0, -4}, {0, -5}, {50, -6}, {103, -7}});
+	CHECK( tape.stats().reallocations == 1 );
+	CHECK( tape.stats().moved_elements == 103 );
+	REQUIRE( tape.size() == (size_t)107 );
+	CHECK( tape[0] == -4 );
+	CHECK( tape[1] == -5 );
+	CHECK( tape[52] == -6 );
+	CHECK( tape.back() == -7 );
+
+	CHECK_THROWS_AS( tape.insert_batch({{0, 0}, {108, 0}}), std::out_of_range );
+	CHECK( tape.size() == (size_t)107 );
+}
+
+/** String whose copies throw once a countdown reaches zero. */
+struct throwing_copy
+{
+	static int countdown;
+	std::string value;
+
+	throwing_copy(const std::string& value):value(value) {}
+	throwing_copy(const throwing_copy& c):value(c.value) {if(countdown-- == 0) throw std::runtime_error("copy");}
+	throwing_copy(throwing_copy&& c) noexcept :value(std::move(c.value)) {}
+	throwing_copy& operator=(const throwing_copy& c) {if(countdown-- == 0) throw std::runtime_error("copy"); value = c.value; return *this;}
+	throwing_copy& operator=(throwing_copy&& c) noexcept {value = std::move(c.value); return *this;}
+};
+int throwing_copy::countdown = -1;
+
+TEST_CASE( "Tape insert batch in slack is undone when a copy throws", "[tape]" ) {
+	std::vector<std::pair<size_t, throwing_copy> > batch;
+	for(size_t pos : {0, 0, 3, 10, 10, 17, 29, 30, 30})
+		batch.push_back(std::make_pair(pos, throwing_copy("value inserted at " + std::to_string(pos))));
+
+	for(size_t before = 0; before <= batch.size(); ++before)
+	{
+		for(int fail = 0; fail < (int)batch.size(); ++fail)
+		{
+			// Exactly enough slack, so the batch is split at before
+			container::tape<throwing_copy> tape;
+			for(int n=0; n<30; ++n)
+				tape.emplace_back("element number " + std::to_string(n));
+			tape.shrink_to_fit();
+			tape.reserve(0, batch.size());
+			tape.recenter(before);
+			std::vector<std::string> ref;
+			for(const throwing_copy& e : tape)
+				ref.push_back(e.value);
+
+			throwing_copy::countdown = fail;
+			CHECK_THROWS_AS( tape.insert_batch(batch.begin(), batch.end()), std::runtime_error );
+			throwing_copy::countdown = -1;
+			REQUIRE( tape.size() == ref.size() );
+			for(size_t n=0; n<ref.size(); ++n)
+				CHECK( tape[n].value == ref[n] );
+		}
+	}
+}
+
+#ifdef CONTAINER_TAPE_HAS_CONSTEXPR
+namespace
+{
+	/** Table of squares, built with a tape at compile time. */
+	constexpr std::array<int, 9> make_table()
+	{
+		container::tape<int> tape;
+		for(int n = 0; n < 3; ++n)
+			tape.push_back(n * n);
+		for(int n = 1; n <= 3; ++n)
+			tape.push_front(-n * n);
+		tape.insert(tape.begin() + 3, 100);
+		tape.insert_batch({{0, 200}, {7, 300}});
+
+		// Reallocations, copies and erasures
+		container::tape<int> other(tape);
+		for(int n = 0; n < 1000; ++n)
+			other.push_front(1000 + n);
+		container::erase_if(other, [](int v){return v >= 1000 && v % 7 != 0;});
+		other.erase(other.begin(), other.begin() + 143);
+
+		std::array<int, 9> res = {};
+		std::copy(other.begin(), other.end(), res.begin());
+		return res;
+	}
+
+	constexpr std::array<int, 9> table = make_table();
+}
+
+TEST_CASE( "Tape in constant expressions", "[tape]" ) {
+	static_assert(table[0] == 200, "tape is constexpr");
+	static_assert(table[1] == -9, "tape is constexpr");
+	static_assert(table[4] == 100, "tape is constexpr");
+	static_assert(table[8] == 300, "tape is constexpr");
+	CHECK( make_table() == (std::array<int, 9>{200, -9, -4, -1, 100, 0, 1, 4, 300}) );
+	CHECK( table == make_table() );
+}
+#endif
+
+template<typename T>
+struct constructing_allocator : std::allocator<T>
+{
+	template<typename U> struct rebind { typedef constructing_allocator<U> other; };
+
+	long* constructed; // Number of elements constructed with this allocator
+	long* destroyed;   // Number of elements destroyed with this allocator
+
+	constructing_allocator(long* constructed, long* destroyed):constructed(constructed), destroyed(destroyed) {}
+	template<typename U> constructing_allocator(const constructing_allocator<U>& a):constructed(a.constructed), destroyed(a.destroyed) {}
+
+	template<typename U, typename... Args>
+	void construct(U* p, Args&&... args) {++*constructed; ::new((void*)p) U(std::forward<Args>(args)...);}
+	template<typename U>
+	void destroy(U* p) {++*destroyed; p->~U();}
+
+	bool operator==(const constructing_allocator&) const {return true;}
+	bool operator!=(const constructing_allocator&) const {return false;}
+};
+
+TEST_CASE( "Tape trivial elements", "[tape]" ) {
+	CHECK_FALSE( container::tape_custom_construct<std::allocator<int>, int>::value );
+	CHECK( container::tape_custom_construct<constructing_allocator<int>, int>::value );
+	CHECK( container::tape_custom_destroy<constructing_allocator<int>, int>::value );
+
+	container::tape<int> tape((size_t)10, 7);
+	tape.push_front(5, (size_t)20);
+	tape.push_back(9, (size_t)30);
+	tape.insert(tape.begin() + 20, (size_t)3, 8);
+	REQUIRE( tape.size() == 63 );
+	CHECK( std::count(tape.begin(), tape.begin() + 20, 5) == 20 );
+	CHECK( std::count(tape.begin() + 20, tape.begin() + 23, 8) == 3 );
+	CHECK( std::count(tape.begin() + 23, tape.begin() + 33, 7) == 10 );
+	CHECK( std::count(tape.begin() + 33, tape.end(), 9) == 30 );
+
+	tape.pop_back(40);
+	tape.pop_front(5);
+	REQUIRE( tape.size() == 18 );
+	CHECK( tape.front() == 5 );
+	CHECK( tape.back() == 8 );
+	tape.pop_back(100);
+	CHECK( tape.empty() );
+
+	// Value-initialized, even in slots previously used
+	tape.resize(40);
+	CHECK( std::count(tape.begin(), tape.end(), 0) == 40 );
+}
+
+TEST_CASE( "Tape fill with an element of itself", "[tape]" ) {
+	container::tape<std::string> tape{"a", "b", "c"};
+	tape.shrink_to_fit();
+	tape.push_back(tape[0], 100);
+	REQUIRE( tape.size() == 103 );
+	CHECK( std::count(tape.begin() + 3, tape.end(), "a") == 100 );
+
+	tape.shrink_to_fit();
+	tape.push_front(tape.back(), 50);
+	REQUIRE( tape.size() == 153 );
+	CHECK( std::count(tape.begin(), tape.begin() + 50, "a") == 50 );
+	CHECK( tape[50] == "a" );
+	CHECK( tape[51] == "b" );
+
+	tape.assign(10, tape[51]);
+	CHECK( tape.size() == 10 );
+	CHECK( std::count(tape.begin(), tape.end(), "b") == 10 );
+
+	tape.resize(300, tape[0]);
+	CHECK( std::count(tape.begin(), tape.end(), "b") == 300 );
+}
+
+TEST_CASE( "Tape fills use allocator construct", "[tape]" ) {
+	long constructed = 0, destroyed = 0;
+	{
+		constructing_allocator<int> alloc(&constructed, &destroyed);
+		container::tape<int, constructing_allocator<int> > tape((size_t)10, 1, alloc);
+		CHECK( constructed == 10 );
+		tape.reserve(100, 100);
+		long before = constructed;
+		tape.push_back(2, (size_t)20);
+		tape.push_front(3, (size_t)30);
+		tape.insert(tape.begin(), (size_t)4, 4);
+		CHECK( constructed - before == 54 );
+		CHECK( constructed - destroyed == 64 );
+		CHECK( tape.size() == 64 );
+
+		before = destroyed;
+		tape.pop_back(20);
+		tape.pop_front(10);
+		CHECK( destroyed - before == 30 );
+		tape.assign((size_t)5, 6);
+		CHECK( destroyed - before == 64 );
+		CHECK( constructed - destroyed == 5 );
+
+		before = constructed;
+		tape.resize(8);
+		CHECK( constructed - before == 3 );
+		CHECK( std::count(tape.begin(), tape.end(), 0) == 3 );
+	}
+	CHECK( constructed == destroyed );
+}
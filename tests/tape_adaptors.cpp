@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "tape_adaptors.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+static_assert(std::is_same<container::queue<int>::container_type, container::tape<int> >::value, "queue defaults to tape");
+static_assert(std::uses_allocator<container::tape<int>, std::allocator<int> >::value, "tape is allocator aware");
+
+TEST_CASE( "Tape queue", "[tape]" ) {
+	container::queue<std::string> queue;
+	CHECK( queue.empty() );
+	for(int n = 0; n < 1000; ++n)
+	{
+		queue.push(std::to_string(n));
+		queue.emplace(3, 'a' + n % 26);
+		queue.pop();
+	}
+	REQUIRE( queue.size() == 1000 );
+	CHECK( queue.front() == "500" );
+	CHECK( queue.back() == std::string(3, 'a' + 999 % 26) );
+
+	container::queue<std::string> other(queue);
+	CHECK( other == queue );
+	other.pop();
+	CHECK( other != queue );
+	CHECK( queue < other ); // "500" < "ggg"
+	swap(other, queue);
+	CHECK( other.size() == 1000 );
+	CHECK( queue.size() == 999 );
+}
+
+TEST_CASE( "Tape queue with a sliding window", "[tape]" ) {
+	typedef container::tape<int, std::allocator<int>, container::tape_no_stats, container::tape_shrink_policy> tape_type;
+	tape_type storage;
+	storage.set_shrink_policy(container::tape_shrink_policy::sliding_window());
+	container::queue<int, tape_type> queue(std::move(storage));
+	for(int n = 0; n < 100000; ++n)
+	{
+		queue.push(n);
+		if(n >= 100)
+			queue.pop();
+	}
+	CHECK( queue.size() == 100 );
+	CHECK( queue.front() == 99900 );
+}
+
+TEST_CASE( "Tape stack", "[tape]" ) {
+	container::stack<int> stack;
+	for(int n = 0; n < 100; ++n)
+		stack.push(n);
+	stack.emplace(1000);
+	CHECK( stack.top() == 1000 );
+	stack.pop();
+	for(int n = 99; n >= 0; --n, stack.pop())
+		CHECK( stack.top() == n );
+	CHECK( stack.empty() );
+}
+
+TEST_CASE( "Tape priority queue", "[tape]" ) {
+	container::priority_queue<int> max;
+	container::priority_queue<int, container::tape<int>, std::greater<int> > min;
+	for(int n = 0; n < 1000; ++n)
+	{
+		max.push((n * 7919) % 1000);
+		min.push((n * 7919) % 1000);
+	}
+	for(int n = 999; n >= 0; --n, max.pop())
+		CHECK( max.top() == n );
+	for(int n = 0; n < 1000; ++n, min.pop())
+		CHECK( min.top() == n );
+
+	int source[] = {3, 1, 4, 1, 5, 9, 2, 6};
+	container::priority_queue<int> ranged(source, source + 8);
+	CHECK( ranged.top() == 9 );
+	CHECK( ranged.size() == 8 );
+}
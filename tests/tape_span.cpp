@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "tape.hpp"
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE( "Tape slice", "[tape]" ) {
+	container::tape<int> tape;
+	for(int n=0; n<20; ++n)
+		tape.push_back(n);
+
+	container::tape_span<int> span = tape.slice(5, 10);
+	REQUIRE( span.size() == (size_t)10 );
+	CHECK( span.data() == tape.data() + 5 );
+	CHECK( span.front() == 5 );
+	CHECK( span.back() == 14 );
+	CHECK( std::accumulate(span.begin(), span.end(), 0) == 95 );
+
+	// Views share elements with the tape
+	span[0] = 100;
+	CHECK( tape[5] == 100 );
+
+	// Length is clamped to the end of the tape
+	CHECK( tape.slice(15, 100).size() == (size_t)5 );
+	CHECK( tape.slice(20, 1).empty() );
+	CHECK_THROWS_AS( tape.slice(21, 0), std::out_of_range );
+
+	const container::tape<int>& ctape = tape;
+	container::tape_span<const int> cspan = ctape.slice(0, 3);
+	CHECK( cspan[2] == 2 );
+	container::tape_span<const int> converted = span;
+	CHECK( converted.data() == span.data() );
+
+#ifdef CONTAINER_TAPE_HAS_STD_SPAN
+	std::span<int> std_span = span;
+	CHECK( std_span.size() == span.size() );
+#endif
+}
+
+TEST_CASE( "Tape span subviews", "[tape]" ) {
+	int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	container::tape_span<int> span(values);
+	REQUIRE( span.size() == (size_t)10 );
+	CHECK( span.size_bytes() == sizeof(values) );
+
+	CHECK( span.first(3).back() == 2 );
+	CHECK( span.last(3).front() == 7 );
+	CHECK( span.subspan(4).size() == (size_t)6 );
+	CHECK( span.subspan(4, 2).back() == 5 );
+	CHECK( span.subspan(10).empty() );
+	CHECK( *span.rbegin() == 9 );
+	CHECK( span.at(9) == 9 );
+
+	CHECK_THROWS_AS( span.first(11), std::out_of_range );
+	CHECK_THROWS_AS( span.last(11), std::out_of_range );
+	CHECK_THROWS_AS( span.subspan(11), std::out_of_range );
+	CHECK_THROWS_AS( span.subspan(5, 6), std::out_of_range );
+	CHECK_THROWS_AS( span.at(10), std::out_of_range );
+}
+
+TEST_CASE( "Strided span", "[tape]" ) {
+	// 4x3 row-major matrix
+	container::tape<int> matrix;
+	for(int n=0; n<12; ++n)
+		matrix.push_back(n);
+
+	// Second column
+	container::strided_span<int> column = matrix.slice(1, 12).stride(3);
+	REQUIRE( column.size() == (size_t)4 );
+	CHECK( column.get_stride() == (size_t)3 );
+	CHECK( std::vector<int>(column.begin(), column.end()) == std::vector<int>({1, 4, 7, 10}) );
+	CHECK( column.back() == 10 );
+	CHECK( column.end() - column.begin() == 4 );
+	CHECK( std::vector<int>(column.rbegin(), column.rend()) == std::vector<int>({10, 7, 4, 1}) );
+
+	column[1] = 40;
+	CHECK( matrix[4] == 40 );
+
+	CHECK( column.subspan(1, 2).front() == 40 );
+	CHECK( column.first(2).back() == 40 );
+	CHECK( column.last(1).front() == 10 );
+	CHECK( column.stride(2).size() == (size_t)2 );
+	CHECK( column.stride(2)[1] == 7 );
+	CHECK( column.stride(2).get_stride() == (size_t)6 );
+	CHECK( !column.is_contiguous() );
+
+	container::strided_span<const int> ccolumn = column;
+	CHECK( ccolumn.at(3) == 10 );
+	CHECK_THROWS_AS( ccolumn.at(4), std::out_of_range );
+	CHECK_THROWS_AS( column.stride(0), std::out_of_range );
+
+	// Stride of a size not multiple of the step
+	CHECK( matrix.slice(0, 11).stride(5).size() == (size_t)3 );
+}
+
+TEST_CASE( "Strided span ending before its stride", "[tape]" ) {
+	// The storage ends one element after the last one of the view: no address past it is computed
+	std::vector<int> storage{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	container::strided_span<int> view = container::tape_span<int>(storage.data(), storage.size()).stride(3);
+	REQUIRE( view.size() == (size_t)4 );
+	CHECK( std::vector<int>(view.begin(), view.end()) == std::vector<int>({0, 3, 6, 9}) );
+	CHECK( std::vector<int>(view.rbegin(), view.rend()) == std::vector<int>({9, 6, 3, 0}) );
+	CHECK( view.end() - view.begin() == 4 );
+	CHECK( view.begin()[3] == 9 );
+	CHECK( view.last(0).empty() );
+	CHECK( view.subspan(4).empty() );
+	CHECK( view.subspan(4).data() == storage.data() + storage.size() );
+}
+
+TEST_CASE( "Strided span with large steps", "[tape]" ) {
+	std::vector<int> storage{0, 1, 2, 3};
+	container::tape_span<int> span(storage.data(), storage.size());
+	const size_t max = (size_t)-1;
+
+	// Element count does not wrap around
+	REQUIRE( span.first(2).stride(max).size() == (size_t)1 );
+	CHECK( span.first(2).stride(max)[0] == 0 );
+	CHECK( span.first(0).stride(max).empty() );
+	CHECK( span.stride(max - 1).size() == (size_t)1 );
+
+	// Stride does not overflow
+	CHECK( span.stride(2).stride(max / 2).get_stride() == max - 1 );
+	CHECK_THROWS_AS( span.stride(2).stride(max / 2 + 1), std::out_of_range );
+	CHECK_THROWS_AS( span.stride(3).stride(max), std::out_of_range );
+}
@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2017-2018 Emilien KIA
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// ----------------------------------------------------------------------------
+
+#include "catch.hpp"
+
+#include "tape_string.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+TEST_CASE( "Tape string construction", "[tape]" ) {
+	container::tape_string empty;
+	CHECK( empty.size() == (size_t)0 );
+	CHECK( empty.empty() );
+	CHECK( std::strcmp(empty.c_str(), "") == 0 );
+
+	container::tape_string hello("hello");
+	CHECK( hello.size() == (size_t)5 );
+	CHECK( hello == "hello" );
+
+	container::tape_string dashes(40, '-');
+	CHECK( dashes.str() == std::string(40, '-') );
+
+	container::tape_string copy(dashes);
+	CHECK( copy == dashes );
+
+	container::tape_string moved(std::move(copy));
+	CHECK( moved == dashes );
+	CHECK( copy.empty() );
+
+	container::tape_string from_std(std::string("from std::string"));
+	CHECK( from_std == "from std::string" );
+}
+
+TEST_CASE( "Tape string append and prepend", "[tape]" ) {
+	container::tape_string str;
+	std::string ref;
+	for(int n=0; n<200; ++n)
+	{
+		std::string chunk = std::to_string(n);
+		if(n % 3)
+		{
+			str.append(chunk.c_str());
+			ref.append(chunk);
+		}
+		else
+		{
+			str.prepend(chunk.c_str());
+			ref.insert(0, chunk);
+		}
+		REQUIRE( str.size() == ref.size() );
+		REQUIRE( std::strcmp(str.c_str(), ref.c_str()) == 0 );
+	}
+
+	str.push_front('<');
+	str.push_back('>');
+	str += "!";
+	str.prepend(2, '#');
+	CHECK( str.str() == "##<" + ref + ">!" );
+}
+
+TEST_CASE( "Tape string stays null-terminated in small and long storage", "[tape]" ) {
+	container::tape_string str("abc");
+	REQUIRE( str.capacity() == container::tape_string::small_capacity );
+	CHECK( str.c_str()[3] == '\0' );
+
+	str.prepend("0123456789");
+	CHECK( str == "0123456789abc" );
+	CHECK( str.c_str()[str.size()] == '\0' );
+
+	str.append("defghijklmnopqrstuvwxyz");
+	str.prepend("header:");
+	CHECK( str == "header:0123456789abcdefghijklmnopqrstuvwxyz" );
+	CHECK( str.c_str()[str.size()] == '\0' );
+
+	str.erase(0, 7);
+	str.erase(10, 3);
+	CHECK( str == "0123456789defghijklmnopqrstuvwxyz" );
+	str.insert(10, "abc");
+	CHECK( str == "0123456789abcdefghijklmnopqrstuvwxyz" );
+	CHECK( str.c_str()[str.size()] == '\0' );
+
+	str.erase(3);
+	str.shrink_to_fit();
+	CHECK( str == "012" );
+	CHECK( str.capacity() == container::tape_string::small_capacity );
+	str.pop_front();
+	str.pop_back();
+	CHECK( str == "1" );
+}
+
+TEST_CASE( "Tape string prepends without reallocation", "[tape]" ) {
+	container::tape_string str(100, 'x');
+	str.reserve_front(1000);
+	REQUIRE( str.capacity_front() >= 1000 );
+	const char* payload = str.data();
+	for(int n=0; n<100; ++n)
+		str.prepend("0123456789");
+	CHECK( str.data() + 1000 == payload );
+	CHECK( str.size() == (size_t)1100 );
+}
+
+TEST_CASE( "Tape string self references", "[tape]" ) {
+	container::tape_string str("0123456789");
+	str.append(str.data(), 5);
+	CHECK( str == "012345678901234" );
+	str.prepend(str.data() + 10, 5);
+	CHECK( str == "01234012345678901234" );
+	str.insert(5, str.data(), 10);
+	CHECK( str == "012340123401234012345678901234" );
+	str.assign(str.data() + 5, 5);
+	CHECK( str == "01234" );
+}
+
+TEST_CASE( "Tape string operations", "[tape]" ) {
+	container::tape_string str("a long enough string to be stored in a tape");
+	CHECK( str.find("string") == (size_t)14 );
+	CHECK( str.find('t') == (size_t)15 );
+	CHECK( str.find("nothing") == container::tape_string::npos );
+	CHECK( str.substr(2, 4) == "long" );
+	CHECK( str.at(0) == 'a' );
+	CHECK_THROWS_AS( str.at(str.size()), std::out_of_range );
+	CHECK_THROWS_AS( str.insert(str.size() + 1, "x"), std::out_of_range );
+
+	CHECK( container::tape_string("abc") < container::tape_string("abd") );
+	CHECK( container::tape_string("ab") < container::tape_string("abc") );
+	CHECK( container::tape_string("abc") != "ab" );
+
+	std::ostringstream os;
+	os << str;
+	CHECK( os.str() == str.str() );
+
+	container::tape_string other("short");
+	swap(str, other);
+	CHECK( str == "short" );
+	CHECK( other.substr(0, 6) == "a long" );
+
+#if __cplusplus >= 201703L
+	std::string_view view = other;
+	CHECK( view == "a long enough string to be stored in a tape" );
+#endif
+}